@@ -0,0 +1,360 @@
+/*
+ *  NumStringConv - number from/to string conversion utilities
+ *  Copyright (C) 2014 Mateusz Szpakowski
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <NumStringConv.h>
+
+using namespace CLRX;
+
+/* simple xorshift generator (reproducible test data) */
+static uint64_t randomState = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t randomLimb()
+{
+    randomState ^= randomState<<13;
+    randomState ^= randomState>>7;
+    randomState ^= randomState<<17;
+    // sometimes generate limbs with all ones (carries)
+    return ((randomState&7) == 0) ? UINT64_MAX : randomState;
+}
+
+/* reference schoolbook product (32-bit digits) */
+static void refMul(cxuint asize, const uint64_t* biga, cxuint bsize, const uint64_t* bigb,
+            uint64_t* bigc)
+{
+    std::fill(bigc, bigc+asize+bsize, uint64_t(0));
+    uint32_t* c32 = new uint32_t[(asize+bsize)<<1];
+    std::fill(c32, c32+((asize+bsize)<<1), uint32_t(0));
+    for (cxuint i = 0; i < (asize<<1); i++)
+    {
+        const uint64_t ai = uint32_t(biga[i>>1]>>((i&1)<<5));
+        uint64_t carry = 0;
+        for (cxuint j = 0; j < (bsize<<1); j++)
+        {
+            const uint64_t bj = uint32_t(bigb[j>>1]>>((j&1)<<5));
+            carry += ai*bj + c32[i+j];
+            c32[i+j] = carry;
+            carry >>= 32;
+        }
+        c32[i+(bsize<<1)] = carry;
+    }
+    for (cxuint i = 0; i < asize+bsize; i++)
+        bigc[i] = c32[i<<1] | (uint64_t(c32[(i<<1)+1])<<32);
+    delete[] c32;
+}
+
+template<cxuint N>
+static std::string bigToString(const BigUInt<N>& v)
+{
+    std::ostringstream oss;
+    for (cxuint i = N; i > 0; i--)
+        oss << std::hex << std::setw(16) << std::setfill('0') << v[i-1];
+    return oss.str();
+}
+
+template<cxuint N>
+static void checkBig(cxuint testId, const char* opName, const BigUInt<N>& result,
+            const BigUInt<N>& expected)
+{
+    if (result != expected)
+    {
+        std::ostringstream oss;
+        oss << "Failed for #" << testId << " " << opName << " with N=" << N <<
+                ". Result: " << bigToString(result) << "!=" << bigToString(expected);
+        oss.flush();
+        throw Exception(oss.str());
+    }
+}
+
+template<cxuint N>
+static void testBigUInt(cxuint testId)
+{
+    BigUInt<N> a, b;
+    for (cxuint i = 0; i < N; i++)
+    {
+        a[i] = randomLimb();
+        b[i] = randomLimb();
+    }
+
+    // (a+b)-b == a
+    checkBig(testId, "add/sub", (a+b)-b, a);
+    // product
+    uint64_t expected[N<<1];
+    refMul(N, a.data(), N, b.data(), expected);
+    BigUInt<N+N> full = a.mulFull(b);
+    checkBig(testId, "mulFull", full, BigUInt<N+N>(N<<1, expected));
+    checkBig(testId, "mul", a*b, BigUInt<N>(N, expected));
+    // round product to nearest (upper half)
+    uint64_t rounded[N<<1];
+    std::copy(expected, expected + (N<<1), rounded);
+    const bool roundCarry = bigUIntRoundToNearest(N<<1, N, rounded);
+    const bool roundUp = (expected[N-1]>>63) != 0;
+    BigUInt<N> roundedRef(N, expected+N);
+    if (roundUp)
+        roundedRef = roundedRef + BigUInt<N>(1);
+    checkBig(testId, "round", BigUInt<N>(N, rounded), roundedRef);
+    if (roundCarry != (roundUp && roundedRef == BigUInt<N>()))
+        throw Exception("Failed round carry");
+    // shifts
+    const cxuint shift = randomLimb() % (N*64);
+    BigUInt<N> shl = a << shift;
+    BigUInt<N> shlRef = a * (BigUInt<N>(1) << shift);
+    checkBig(testId, "shl", shl, shlRef);
+    checkBig(testId, "shr", (shl >> shift) << shift, shl);
+    checkBig(testId, "shr64", (BigUInt<N+1>(a) << 64) >> 64, BigUInt<N+1>(a));
+    // compare
+    if ((a < b) == (b < a) && a != b)
+        throw Exception("Failed compare");
+    const BigUInt<N> allOnes = BigUInt<N>() - BigUInt<N>(1);
+    if (a != allOnes && !(a+BigUInt<N>(1) > a))
+        throw Exception("Failed compare with a+1");
+    if (a.bitLength() != 0 && (a >> (a.bitLength()-1)) != BigUInt<N>(1))
+        throw Exception("Failed bitLength");
+}
+
+struct CStrtoBigTestCase
+{
+    const char* string;
+    cxuint size;
+    uint64_t expected[4];
+    bool outOfRange;
+};
+
+static const CStrtoBigTestCase cstrtoBigTestCases[] =
+{
+    { "0", 2, { 0, 0 }, false },
+    { "0x0000", 2, { 0, 0 }, false },
+    { "18446744073709551615", 1, { UINT64_MAX }, false },
+    { "18446744073709551616", 1, { }, true },
+    { "18446744073709551616", 2, { 0, 1 }, false },
+    { "340282366920938463463374607431768211455", 2, { UINT64_MAX, UINT64_MAX }, false },
+    { "340282366920938463463374607431768211456", 2, { }, true },
+    { "0xfedcba9876543210aabbccddeeff0011", 2,
+        { 0xaabbccddeeff0011ULL, 0xfedcba9876543210ULL }, false },
+    { "0x1fedcba9876543210aabbccddeeff0011", 2, { }, true },
+    { "0x000000000fedcba9876543210aabbccddeeff0011", 2,
+        { 0xaabbccddeeff0011ULL, 0xfedcba9876543210ULL }, false },
+    { "01777777777777777777777", 1, { UINT64_MAX }, false },
+    { "02000000000000000000000", 1, { }, true },
+    { "02000000000000000000000", 2, { 0, 1 }, false },
+    { "0b1101000000000000000000000000000000000000000000000000000000000000001", 2,
+        { 0x8000000000000001ULL, 6 }, false },
+    { "115792089237316195423570985008687907853269984665640564039457584007913129639935",
+        4, { UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX }, false },
+    { "115792089237316195423570985008687907853269984665640564039457584007913129639936",
+        4, { }, true }
+};
+
+static void testCStrtoBig(cxuint testId, const CStrtoBigTestCase& testCase)
+{
+    uint64_t result[4];
+    const char* end;
+    bool outOfRange = false;
+    try
+    {
+        cstrtobigCStyle(testCase.string, testCase.string+::strlen(testCase.string), end,
+                testCase.size, result);
+    }
+    catch(const ParseException& ex)
+    { outOfRange = true; }
+    if (outOfRange != testCase.outOfRange ||
+        (!outOfRange && (::memcmp(result, testCase.expected, testCase.size<<3) != 0 ||
+            end != testCase.string+::strlen(testCase.string))))
+    {
+        std::ostringstream oss;
+        oss << "Failed for cstrtobig #" << testId << " with string='" <<
+                testCase.string << "'";
+        oss.flush();
+        throw Exception(oss.str());
+    }
+}
+
+/* compare long decimal conversion with reference (sum of digit*10**i) */
+template<cxuint N>
+static void testCStrtoBigDecimal(cxuint testId)
+{
+    char digits[N*20];
+    const cxuint digitsNum = 1 + randomLimb()%(N*19);
+    BigUInt<N> expected;
+    for (cxuint i = 0; i < digitsNum; i++)
+    {
+        const cxuint digit = (i == 0) ? 1+randomLimb()%9 : randomLimb()%10;
+        digits[i] = '0'+digit;
+        expected = expected*BigUInt<N>(10) + BigUInt<N>(digit);
+    }
+    BigUInt<N> result;
+    const char* end;
+    cstrtobigCStyle(digits, digits+digitsNum, end, N, result.data());
+    checkBig(testId, "cstrtobig", result, expected);
+}
+
+/* format and parse back number in all radices */
+template<cxuint N>
+static void testBigtoCStr(cxuint testId)
+{
+    BigUInt<N> value;
+    const cxuint limbsNum = 1 + randomLimb()%N;
+    for (cxuint i = 0; i < limbsNum; i++)
+        value[i] = randomLimb();
+    static const cxuint radices[4] = { 2, 8, 10, 16 };
+    char buf[N*64+10];
+    for (cxuint radix: radices)
+    {
+        bigtocstrCStyle(N, value.data(), buf, N*64+10, radix);
+        BigUInt<N> result;
+        const char* end;
+        cstrtobigCStyle(buf, buf+::strlen(buf), end, N, result.data());
+        checkBig(testId, "bigtocstr", result, value);
+    }
+    // decimal digits by reference (value%10)
+    char expected[N*20+1];
+    cxuint digitsNum = 0;
+    for (BigUInt<N> tval = value; !tval.isZero(); digitsNum++)
+    {
+        uint64_t rem = 0;
+        for (cxuint i = N; i > 0; i--)
+        {   // divide by 10 (32-bit parts)
+            const uint64_t hi = (rem<<32) | (tval[i-1]>>32);
+            const uint64_t lo = ((hi%10)<<32) | (tval[i-1]&0xffffffffULL);
+            tval[i-1] = ((hi/10)<<32) | (lo/10);
+            rem = lo%10;
+        }
+        expected[digitsNum] = '0'+rem;
+    }
+    std::reverse(expected, expected+digitsNum);
+    expected[digitsNum] = 0;
+    bigtocstrCStyle(N, value.data(), buf, N*64+10);
+    if (::strcmp(buf, expected) != 0)
+    {
+        std::ostringstream oss;
+        oss << "Failed for bigtocstr #" << testId << " with N=" << N <<
+                ". Result: " << buf << "!=" << expected;
+        oss.flush();
+        throw Exception(oss.str());
+    }
+}
+
+/* single limb must be formatted like u64tocstrCStyle */
+static void testBigtoCStrU64(cxuint testId)
+{
+    const uint64_t value[2] = { randomLimb() >> (randomLimb()&63), 0 };
+    static const cxuint radices[4] = { 2, 8, 10, 16 };
+    for (cxuint radix: radices)
+    {
+        char buf[100], expected[100];
+        const cxuint width = randomLimb()%80;
+        const bool prefix = (randomLimb()&1) != 0;
+        u64tocstrCStyle(value[0], expected, 100, radix, width, prefix);
+        bigtocstrCStyle(2, value, buf, 100, radix, width, prefix);
+        if (::strcmp(buf, expected) != 0)
+        {
+            std::ostringstream oss;
+            oss << "Failed for bigtocstr #" << testId << " with radix=" << radix <<
+                    ". Result: " << buf << "!=" << expected;
+            oss.flush();
+            throw Exception(oss.str());
+        }
+    }
+}
+
+/* powers of 10, numbers with only nines and powers of 10 with short tail (parts
+ * of divide-and-conquer splits are much smaller than powers) must be formatted back */
+static void testBigtoCStrDecBoundaries(cxuint testId)
+{
+    const size_t digitsNum = 2000 + randomLimb()%12000;
+    const cxuint size = digitsNum/19 + 2;
+    for (cxuint kind = 0; kind < 3; kind++)
+    {
+        std::string digits(digitsNum, (kind == 1) ? '9' : '0');
+        if (kind != 1)
+            digits.insert(digits.begin(), '1');
+        if (kind == 2)
+            for (size_t i = digits.size() - digitsNum/3; i < digits.size(); i++)
+                digits[i] = '0' + randomLimb()%10;
+        std::vector<uint64_t> value(size);
+        const char* end;
+        cstrtobigCStyle(digits.c_str(), digits.c_str()+digits.size(), end, size,
+                    value.data());
+        std::vector<char> buf(digits.size()+1);
+        bigtocstrCStyle(size, value.data(), buf.data(), buf.size());
+        if (digits != buf.data())
+        {
+            std::ostringstream oss;
+            oss << "Failed for bigtocstr #" << testId << " with kind=" << kind <<
+                    " and digitsNum=" << digitsNum;
+            oss.flush();
+            throw Exception(oss.str());
+        }
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    int retVal = 0;
+    for (cxuint i = 0; i < 2000; i++)
+        try
+        {
+            testBigUInt<1>(i);
+            testBigUInt<2>(i);
+            testBigUInt<3>(i);
+            testBigUInt<4>(i);
+            testBigUInt<8>(i);
+            testBigUInt<13>(i);
+            testBigUInt<16>(i);
+            testBigtoCStr<1>(i);
+            testBigtoCStr<3>(i);
+            testBigtoCStrU64(i);
+            if ((i % 20) == 0)
+            {
+                testBigUInt<37>(i);
+                testBigUInt<128>(i);
+                testBigUInt<300>(i);
+                testCStrtoBigDecimal<4>(i);
+                testCStrtoBigDecimal<19>(i);
+                testCStrtoBigDecimal<64>(i);
+                testBigtoCStr<17>(i);
+                testBigtoCStr<40>(i);
+                testBigtoCStr<300>(i);
+                testBigtoCStrDecBoundaries(i);
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            retVal = 1;
+        }
+    for (cxuint i = 0; i < sizeof(cstrtoBigTestCases)/sizeof(CStrtoBigTestCase); i++)
+        try
+        {
+            testCStrtoBig(i, cstrtoBigTestCases[i]);
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            retVal = 1;
+        }
+    return retVal;
+}
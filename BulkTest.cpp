@@ -0,0 +1,197 @@
+/*
+ *  NumStringConv - number from/to string conversion utilities
+ *  Copyright (C) 2014 Mateusz Szpakowski
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/* tests of bulk modes of tools (must be run from build directory) */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <NumStringConv.h>
+
+using namespace CLRX;
+
+static const char* inFileName = "BulkTestIn.tmp";
+static const char* outFileName = "BulkTestOut.tmp";
+static const char* errFileName = "BulkTestErr.tmp";
+static const char* binFileName = "BulkTestBin.tmp";
+
+static void writeFile(const char* filename, const void* data, size_t size)
+{
+    FILE* file = ::fopen(filename, "wb");
+    if (file == nullptr)
+        throw Exception(std::string("Cant open file ") + filename);
+    const bool failed = ::fwrite(data, 1, size, file) != size;
+    if (::fclose(file) != 0 || failed)
+        throw Exception(std::string("Cant write file ") + filename);
+}
+
+static std::string readFile(const char* filename)
+{
+    FILE* file = ::fopen(filename, "rb");
+    if (file == nullptr)
+        throw Exception(std::string("Cant open file ") + filename);
+    std::string content;
+    char buffer[4096];
+    size_t readSize;
+    while ((readSize = ::fread(buffer, 1, sizeof buffer, file)) != 0)
+        content.append(buffer, readSize);
+    ::fclose(file);
+    return content;
+}
+
+/* run command with redirected outputs, returns true if command succeeded */
+static bool runCommand(const std::string& command)
+{
+    const std::string line = command + " > " + outFileName + " 2> " + errFileName;
+    return std::system(line.c_str()) == 0;
+}
+
+static void removeFiles()
+{
+    ::remove(inFileName);
+    ::remove(outFileName);
+    ::remove(errFileName);
+    ::remove(binFileName);
+}
+
+struct BulkTestCase
+{
+    const char* input;
+    char type;
+    std::vector<double> expected;
+    std::vector<size_t> errorOffsets;
+};
+
+static const BulkTestCase bulkTestCases[] =
+{
+    { "1 2.5, -3e1;+0x1p-2", 'd', { 1.0, 2.5, -30.0, 0.25 }, { } },
+    { "1-2 2024-01-01", 'd', { 1.0, -2.0, 2024.0, -1.0, -1.0 }, { } },
+    { "1e-5 1E+2 0x1e-5 0x1P+1", 'd', { 1e-5, 100.0, 30.0, -5.0, 2.0 }, { } },
+    { "abc x1 _2 7", 'd', { 7.0 }, { } },
+    { "1 3x 5 1.2.3 9", 'd', { 1.0, 0.0, 5.0, 0.0, 9.0 }, { 2, 7 } },
+    { "12,0x10,99999999999", 'i', { 12.0, 16.0, 0.0 }, { 8 } },
+    { "0.5 65504 1e10", 'h', { 0.5, 65504.0, 0.0 }, { 10 } }
+};
+
+/* convert input by cstrtoXBulk and compare values and reported offsets of errors */
+static void testCStrtoXBulk(cxuint testId, const BulkTestCase& testCase)
+{
+    writeFile(inFileName, testCase.input, ::strlen(testCase.input));
+    const bool succeeded = runCommand(std::string("./cstrtoXBulk ") + inFileName + " " +
+            binFileName + " " + testCase.type + " 2");
+    const std::string output = readFile(binFileName);
+    const std::string errors = readFile(errFileName);
+
+    std::vector<double> values;
+    const size_t elemSize = (testCase.type == 'h') ? 2 : (testCase.type == 'i') ? 4 : 8;
+    for (size_t i = 0; i+elemSize <= output.size(); i += elemSize)
+    {
+        if (testCase.type == 'h')
+        {
+            cxushort value;
+            ::memcpy(&value, output.data()+i, 2);
+            // only finite values in test cases
+            const cxint exponent = (value>>10)&31;
+            const double mantisa = (exponent != 0) ? (value&1023)|1024 : (value&1023);
+            values.push_back(((value&0x8000) ? -1.0 : 1.0) *
+                    ::ldexp(mantisa, std::max(exponent, 1)-25));
+        }
+        else if (testCase.type == 'i')
+        {
+            uint32_t value;
+            ::memcpy(&value, output.data()+i, 4);
+            values.push_back(value);
+        }
+        else
+        {
+            double value;
+            ::memcpy(&value, output.data()+i, 8);
+            values.push_back(value);
+        }
+    }
+    std::string expectedErrors;
+    for (size_t offset: testCase.errorOffsets)
+        expectedErrors += "Offset " + std::to_string(offset) + ":";
+    std::string resultErrors;
+    for (size_t pos = 0; (pos = errors.find("Offset ", pos)) != std::string::npos; pos++)
+        resultErrors += errors.substr(pos, errors.find(':', pos)-pos+1);
+
+    if (output.size() != testCase.expected.size()*elemSize ||
+        values != testCase.expected || resultErrors != expectedErrors ||
+        succeeded != testCase.errorOffsets.empty())
+    {
+        std::ostringstream oss;
+        oss << "Failed for cstrtoXBulk#" << testId << " '" << testCase.input << "'";
+        throw Exception(oss.str());
+    }
+}
+
+/* format all half floats and chunk of longest hexadecimal values by fXtocstrCStyle
+ * in hexadecimal mode and compare lines with htocstrHexCStyle */
+static void testFXtocstrBulkHalfHex()
+{
+    std::vector<cxushort> values(1U<<17);
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = (i < (1U<<16)) ? i : 0xfbff;
+    writeFile(binFileName, values.data(), values.size()*sizeof(cxushort));
+    if (!runCommand(std::string("./fXtocstrCStyle -b ") + binFileName + " h x 2"))
+        throw Exception("Failed for fXtocstrCStyle bulk hex: " + readFile(errFileName));
+    const std::string output = readFile(outFileName);
+    std::string expected;
+    for (cxushort value: values)
+    {
+        char buffer[HTOCSTR_HEX_MAX_LENGTH+1];
+        expected.append(buffer, htocstrHexCStyle(value, buffer, HTOCSTR_HEX_MAX_LENGTH+1));
+        expected.push_back('\n');
+    }
+    if (output != expected)
+        throw Exception("Failed for fXtocstrCStyle bulk hex");
+}
+
+int main(int argc, const char** argv)
+{
+    int retVal = 0;
+    for (cxuint i = 0; i < sizeof(bulkTestCases)/sizeof(BulkTestCase); i++)
+        try
+        {
+            testCStrtoXBulk(i, bulkTestCases[i]);
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            retVal = 1;
+        }
+    try
+    {
+        testFXtocstrBulkHalfHex();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    removeFiles();
+    return retVal;
+}
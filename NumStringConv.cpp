@@ -28,9 +28,28 @@
 #include <locale>
 #include <cstdint>
 #include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <exception>
 #include <alloca.h>
 #include <climits>
 #include <cstddef>
+/* HAVE_SSE2 - use SSE2 for formatting of long decimal numbers, parsing of short
+ * numbers and narrowing of wide characters (define NO_SSE2 to disable) */
+#if defined(__SSE2__) && !defined(NO_SSE2)
+#  define HAVE_SSE2 1
+#  include <emmintrin.h>
+#  ifdef __SSSE3__
+#    include <tmmintrin.h>
+#  elif defined(__GNUC__)
+/* HAVE_SSSE3_DISPATCH - SSSE3 code is compiled for single functions and choosen
+ * at runtime if CPU supports SSSE3 */
+#    define HAVE_SSSE3_DISPATCH 1
+#    include <tmmintrin.h>
+#  endif
+#endif
 #include <NumStringConv.h>
 
 using namespace CLRX;
@@ -251,6 +270,48 @@ static inline void mul64Full(uint64_t a, uint64_t b, uint64_t* c)
 #endif
 }
 
+/* divide 128-bit number (hi,lo) by 64-bit value, hi must be smaller than d */
+static inline uint64_t div128By64(uint64_t hi, uint64_t lo, uint64_t d, uint64_t& rem)
+{
+#ifdef HAVE_INT128
+    const unsigned __int128 n = (((unsigned __int128)hi)<<64) | lo;
+    rem = n % d;
+    return n / d;
+#else
+    /* long division with 32-bit digits (normalized divisor) */
+    const cxuint shift = CLZ64(d);
+    d <<= shift;
+    if (shift != 0)
+        hi = (hi<<shift) | (lo>>(64-shift));
+    lo <<= shift;
+    const uint64_t dh = d>>32;
+    const uint64_t dl = d&0xffffffffULL;
+    const uint64_t lh = lo>>32;
+    const uint64_t ll = lo&0xffffffffULL;
+    uint64_t q1 = hi/dh;
+    uint64_t rhat = hi - q1*dh;
+    while (q1 >= (1ULL<<32) || q1*dl > ((rhat<<32)|lh))
+    {
+        q1--;
+        rhat += dh;
+        if (rhat >= (1ULL<<32))
+            break;
+    }
+    const uint64_t un21 = (hi<<32) + lh - q1*d;
+    uint64_t q0 = un21/dh;
+    rhat = un21 - q0*dh;
+    while (q0 >= (1ULL<<32) || q0*dl > ((rhat<<32)|ll))
+    {
+        q0--;
+        rhat += dh;
+        if (rhat >= (1ULL<<32))
+            break;
+    }
+    rem = ((un21<<32) + ll - q0*d) >> shift;
+    return (q1<<32) | q0;
+#endif
+}
+
 static inline bool bigAdd(cxuint aSize, const uint64_t* biga, const uint64_t* bigb,
               uint64_t* bigc)
 {
@@ -331,6 +392,222 @@ static inline bool bigSub(cxuint aSize, uint64_t* biga, cxuint bSize, const uint
     return borrow;
 }
 
+/*
+ * fixed-size big number kernels
+ * these kernels are fully unrolled by templates (I - current limb, N - end limb),
+ * values are kept in registers and no stack allocation is needed.
+ */
+
+/* multiply single 64-bit value by bigb and add to bigc (J - current limb, B - bsize) */
+template<cxuint J, cxuint B>
+struct BigFixedMulRow
+{
+    static inline uint64_t mulAdd(uint64_t a, const uint64_t* bigb, uint64_t* bigc,
+                uint64_t carry)
+    {
+#ifdef HAVE_INT128
+        const unsigned __int128 t = ((unsigned __int128)a)*bigb[J] + bigc[J] + carry;
+        bigc[J] = t;
+        carry = t>>64;
+#else
+        uint64_t t[2];
+        mul64Full(a, bigb[J], t);
+        t[0] += carry;
+        t[1] += (t[0] < carry);
+        bigc[J] += t[0];
+        t[1] += (bigc[J] < t[0]);
+        carry = t[1];
+#endif
+        return BigFixedMulRow<J+1, B>::mulAdd(a, bigb, bigc, carry);
+    }
+};
+
+template<cxuint B>
+struct BigFixedMulRow<B, B>
+{
+    static inline uint64_t mulAdd(uint64_t, const uint64_t*, uint64_t*, uint64_t carry)
+    { return carry; }
+};
+
+template<cxuint I, cxuint N>
+struct BigFixedUnroll
+{
+    /* biga+bigb with carry */
+    static inline bool add(uint64_t* biga, const uint64_t* bigb, bool carry)
+    {
+        biga[I] += bigb[I] + carry;
+        carry = (biga[I] < bigb[I]) || ((biga[I] == bigb[I]) && carry);
+        return BigFixedUnroll<I+1, N>::add(biga, bigb, carry);
+    }
+    /* propagate carry */
+    static inline bool addCarry(uint64_t* biga, bool carry)
+    {
+        biga[I] += carry;
+        carry = (biga[I] < uint64_t(carry));
+        return BigFixedUnroll<I+1, N>::addCarry(biga, carry);
+    }
+    /* biga-bigb with borrow */
+    static inline bool sub(uint64_t* biga, const uint64_t* bigb, bool borrow)
+    {
+        const uint64_t tmp = biga[I];
+        biga[I] -= bigb[I] + borrow;
+        borrow = (biga[I] > tmp) || (biga[I] == tmp && borrow);
+        return BigFixedUnroll<I+1, N>::sub(biga, bigb, borrow);
+    }
+    /* propagate borrow */
+    static inline bool subBorrow(uint64_t* biga, bool borrow)
+    {
+        const uint64_t tmp = biga[I];
+        biga[I] -= borrow;
+        borrow = (biga[I] > tmp);
+        return BigFixedUnroll<I+1, N>::subBorrow(biga, borrow);
+    }
+    /* copy src to dest with adding carry (used by rounding) */
+    static inline bool copyCarry(uint64_t* dest, const uint64_t* src, bool carry)
+    {
+        dest[I] = src[I] + carry;
+        carry = (dest[I] < uint64_t(carry));
+        return BigFixedUnroll<I+1, N>::copyCarry(dest, src, carry);
+    }
+    static inline void zero(uint64_t* bigc)
+    {
+        bigc[I] = 0;
+        BigFixedUnroll<I+1, N>::zero(bigc);
+    }
+    /* row-wise product: bigc[I+B] = carry of row I */
+    template<cxuint B>
+    static inline void mul(const uint64_t* biga, const uint64_t* bigb, uint64_t* bigc)
+    {
+        bigc[I+B] = BigFixedMulRow<0, B>::mulAdd(biga[I], bigb, bigc+I, 0);
+        BigFixedUnroll<I+1, N>::template mul<B>(biga, bigb, bigc);
+    }
+};
+
+template<cxuint N>
+struct BigFixedUnroll<N, N>
+{
+    static inline bool add(uint64_t*, const uint64_t*, bool carry)
+    { return carry; }
+    static inline bool addCarry(uint64_t*, bool carry)
+    { return carry; }
+    static inline bool sub(uint64_t*, const uint64_t*, bool borrow)
+    { return borrow; }
+    static inline bool subBorrow(uint64_t*, bool borrow)
+    { return borrow; }
+    static inline bool copyCarry(uint64_t*, const uint64_t*, bool carry)
+    { return carry; }
+    static inline void zero(uint64_t*)
+    { }
+    template<cxuint B>
+    static inline void mul(const uint64_t*, const uint64_t*, uint64_t*)
+    { }
+};
+
+/* biga (ASize) + bigb (BSize), ASize >= BSize, returns carry */
+template<cxuint ASize, cxuint BSize>
+static inline bool bigAddFixed(uint64_t* biga, const uint64_t* bigb)
+{
+    const bool carry = BigFixedUnroll<0, BSize>::add(biga, bigb, false);
+    return BigFixedUnroll<BSize, ASize>::addCarry(biga, carry);
+}
+
+/* biga (ASize) - bigb (BSize), ASize >= BSize, returns borrow */
+template<cxuint ASize, cxuint BSize>
+static inline bool bigSubFixed(uint64_t* biga, const uint64_t* bigb)
+{
+    const bool borrow = BigFixedUnroll<0, BSize>::sub(biga, bigb, false);
+    return BigFixedUnroll<BSize, ASize>::subBorrow(biga, borrow);
+}
+
+/* bigc (ASize+BSize) = biga (ASize) * bigb (BSize) */
+template<cxuint ASize, cxuint BSize>
+static inline void bigMulFixed(const uint64_t* biga, const uint64_t* bigb, uint64_t* bigc)
+{
+    BigFixedUnroll<0, BSize>::zero(bigc);
+    BigFixedUnroll<0, ASize>::template mul<BSize>(biga, bigb, bigc);
+}
+
+/* fixed-size version of bigFPRoundToNearest */
+template<cxuint InSize, cxuint OutSize>
+static inline bool bigFPRoundToNearestFixed(cxint& exponent, uint64_t* bigNum)
+{
+    const cxuint roundSize = InSize-OutSize;
+    const bool carry = BigFixedUnroll<0, OutSize>::copyCarry(bigNum, bigNum+roundSize,
+                (bigNum[roundSize-1] & (1ULL<<63)) != 0);
+    if (carry)
+        exponent++;
+    return carry;
+}
+
+/* dispatch rounding of products of fixed-size kernels (2*outSize to outSize),
+ * returns false if sizes are not handled */
+static inline bool bigFPRoundToNearestFixedDispatch(cxuint inSize, cxuint outSize,
+           cxint& exponent, uint64_t* bigNum, bool& carry)
+{
+    if (inSize != (outSize<<1))
+        return false;
+    switch (outSize)
+    {
+        case 2:
+            carry = bigFPRoundToNearestFixed<4, 2>(exponent, bigNum);
+            return true;
+        case 3:
+            carry = bigFPRoundToNearestFixed<6, 3>(exponent, bigNum);
+            return true;
+        case 4:
+            carry = bigFPRoundToNearestFixed<8, 4>(exponent, bigNum);
+            return true;
+        case 5:
+            carry = bigFPRoundToNearestFixed<10, 5>(exponent, bigNum);
+            return true;
+        case 6:
+            carry = bigFPRoundToNearestFixed<12, 6>(exponent, bigNum);
+            return true;
+        case 7:
+            carry = bigFPRoundToNearestFixed<14, 7>(exponent, bigNum);
+            return true;
+        case 8:
+            carry = bigFPRoundToNearestFixed<16, 8>(exponent, bigNum);
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* dispatch to fixed-size kernels, returns false if sizes are not handled */
+static inline bool bigMulFixedDispatch(cxuint asize, const uint64_t* biga, cxuint bsize,
+           const uint64_t* bigb, uint64_t* bigc)
+{
+    if (asize != bsize)
+        return false;
+    switch (asize)
+    {
+        case 2:
+            bigMulFixed<2, 2>(biga, bigb, bigc);
+            return true;
+        case 3:
+            bigMulFixed<3, 3>(biga, bigb, bigc);
+            return true;
+        case 4:
+            bigMulFixed<4, 4>(biga, bigb, bigc);
+            return true;
+        case 5:
+            bigMulFixed<5, 5>(biga, bigb, bigc);
+            return true;
+        case 6:
+            bigMulFixed<6, 6>(biga, bigb, bigc);
+            return true;
+        case 7:
+            bigMulFixed<7, 7>(biga, bigb, bigc);
+            return true;
+        case 8:
+            bigMulFixed<8, 8>(biga, bigb, bigc);
+            return true;
+        default:
+            return false;
+    }
+}
+
 #ifdef HAVE_INT128
 /*
  * bigMulSimple
@@ -338,34 +615,20 @@ static inline bool bigSub(cxuint aSize, uint64_t* biga, cxuint bSize, const uint
 static void bigMulSimple(cxuint asize, const uint64_t* biga, cxuint bsize,
            const uint64_t* bigb, uint64_t* bigc)
 {
-    uint64_t* tmpMul = static_cast<uint64_t*>(::alloca((bsize+1)<<3));
-    std::fill(bigc, bigc + asize + bsize, uint64_t(0));
+    if (bigMulFixedDispatch(asize, biga, bsize, bigb, bigc))
+        return;
+    std::fill(bigc, bigc + bsize, uint64_t(0));
     for (cxuint i = 0; i < asize; i++)
-    {
-        uint64_t t[2];
-        tmpMul[0] = tmpMul[1] = 0;
-        for (cxuint j = 0; j < bsize-1; j++)
-        {
-            mul64Full(biga[i], bigb[j], t);
-            // add to bigc
-            tmpMul[j] += t[0];
-            bool carry = (tmpMul[j] < t[0]);
-            tmpMul[j+1] += t[1] + carry;
-            tmpMul[j+2] = (tmpMul[j+1] < t[1]) || (tmpMul[j+1] == t[1] && carry);
-        }
-        mul64Full(biga[i], bigb[bsize-1], t);
-        tmpMul[bsize-1] += t[0];
-        bool carry = (tmpMul[bsize-1] < t[0]);
-        tmpMul[bsize] += t[1] + carry;
-        // add to product
-        carry = false;
-        for (cxuint j = 0; j < bsize+1; j++)
+    {   // multiply and add row (no temporary buffer is needed)
+        uint64_t carry = 0;
+        for (cxuint j = 0; j < bsize; j++)
         {
-            bigc[i+j] += tmpMul[j] + carry;
-            carry = (bigc[i+j] < tmpMul[j]) || ((bigc[i+j] == tmpMul[j]) && carry);
+            const unsigned __int128 t = ((unsigned __int128)biga[i])*bigb[j] +
+                    bigc[i+j] + carry;
+            bigc[i+j] = t;
+            carry = t>>64;
         }
-        if (i+bsize+1 < asize+bsize)
-            bigc[i+bsize+1] += carry;
+        bigc[i+bsize] = carry;
     }
 }
 #endif
@@ -677,8 +940,10 @@ static inline void bigShift64Right(cxuint size, uint64_t* bigNum, cxuint shift64
 static bool bigFPRoundToNearest(cxuint inSize, cxuint outSize, cxint& exponent,
             uint64_t* bigNum)
 {
-    const cxuint roundSize = inSize-outSize;
     bool carry = false;
+    if (bigFPRoundToNearestFixedDispatch(inSize, outSize, exponent, bigNum, carry))
+        return carry;
+    const cxuint roundSize = inSize-outSize;
     if ((bigNum[roundSize-1] & (1ULL<<63)) != 0)
     {   /* apply rounding */
         carry = true;
@@ -697,6 +962,70 @@ static bool bigFPRoundToNearest(cxuint inSize, cxuint outSize, cxint& exponent,
     return carry;
 }
 
+/*
+ * public big unsigned integer kernels
+ */
+
+bool CLRX::bigUIntAdd(cxuint aSize, uint64_t* biga, cxuint bSize, const uint64_t* bigb)
+{
+    return bigAdd(aSize, biga, bSize, bigb);
+}
+
+bool CLRX::bigUIntSub(cxuint aSize, uint64_t* biga, cxuint bSize, const uint64_t* bigb)
+{
+    return bigSub(aSize, biga, bSize, bigb);
+}
+
+void CLRX::bigUIntMul(cxuint aSize, const uint64_t* biga, cxuint bSize,
+            const uint64_t* bigb, uint64_t* bigc)
+{
+    bigMul(aSize, biga, bSize, bigb, bigc);
+}
+
+void CLRX::bigUIntShiftRight(cxuint size, uint64_t* bigNum, cxuint shift)
+{
+    const cxuint limbShift = std::min(shift>>6, size);
+    if (limbShift != 0)
+    {
+        std::copy(bigNum + limbShift, bigNum + size, bigNum);
+        std::fill(bigNum + size - limbShift, bigNum + size, uint64_t(0));
+    }
+    if ((shift&63) != 0 && limbShift < size)
+        bigShift64Right(size - limbShift, bigNum, shift&63);
+}
+
+void CLRX::bigUIntShiftLeft(cxuint size, uint64_t* bigNum, cxuint shift)
+{
+    const cxuint limbShift = std::min(shift>>6, size);
+    if (limbShift != 0)
+    {
+        std::copy_backward(bigNum, bigNum + size - limbShift, bigNum + size);
+        std::fill(bigNum, bigNum + limbShift, uint64_t(0));
+    }
+    const cxuint shift64 = shift&63;
+    if (shift64 != 0)
+    {
+        for (cxuint i = size-1; i > limbShift; i--)
+            bigNum[i] = (bigNum[i]<<shift64) | (bigNum[i-1]>>(64-shift64));
+        if (limbShift < size)
+            bigNum[limbShift] <<= shift64;
+    }
+}
+
+bool CLRX::bigUIntRoundToNearest(cxuint inSize, cxuint outSize, uint64_t* bigNum)
+{
+    cxint exponent = 0;
+    return bigFPRoundToNearest(inSize, outSize, exponent, bigNum);
+}
+
+cxint CLRX::bigUIntCompare(cxuint size, const uint64_t* biga, const uint64_t* bigb)
+{
+    for (cxuint i = size; i > 0; i--)
+        if (biga[i-1] != bigb[i-1])
+            return (biga[i-1] < bigb[i-1]) ? -1 : 1;
+    return 0;
+}
+
 struct Pow5Num128TableEntry
 {
     uint64_t value[2];
@@ -879,34 +1208,52 @@ static void bigMulFP(cxuint maxSize,
     }
 }
 
-/* generate bit Power of 5.
- * power - power, maxSize - max size of number
- * outSize - size of output number
- * exponent - output number exponent
- * outPow - output number
- * Number in format: (1 + outNumber/2**(dstsize*64)) * 2**exponent
- */
-static void bigPow5(cxint power, cxuint maxSize, cxuint& powSize,
+#ifdef HAVE_POW5_TABLES
+/* extended precision powers of 5 (generated at build time by genPow5Tables) */
+#include <NumStringConvPow5Tables.inc>
+
+/* get big power of 5 from extended precision table. power is sum of
+ * table power (multiple of stride) and small rest, so only one multiply is needed.
+ * requires maxSize+1 < POW5_TABLE_LIMBS */
+static void bigPow5FromTable(cxint power, cxuint maxSize, cxuint& powSize,
             cxint& exponent, uint64_t* outPow)
 {
-    if ((power >= 0 && power < 28) ||
-        (maxSize == 1 && power >= -64 && power <= 64))
-    {   /* get result from table */
-        outPow[0] = pow5_128Table[power+64].value[1] +
-                (pow5_128Table[power+64].value[0]>>63);
-        powSize = 1;
-        exponent = pow5_128Table[power+64].exponent;
+    const cxuint tablePos = power - POW5_TABLE_MIN_POWER;
+    const Pow5BigTableEntry& entry = pow5BigTable[tablePos / POW5_TABLE_STRIDE];
+    const cxuint rest = tablePos % POW5_TABLE_STRIDE;
+    uint64_t tablePow[POW5_TABLE_LIMBS];
+    std::copy(entry.value, entry.value + POW5_TABLE_LIMBS, tablePow);
+    exponent = entry.exponent;
+    if (rest == 0)
+    {   // only round table value
+        bigFPRoundToNearest(POW5_TABLE_LIMBS, maxSize, exponent, tablePow);
+        std::copy(tablePow, tablePow + maxSize, outPow);
+        powSize = maxSize;
         return;
     }
-    if (maxSize == 2 && power >= -64 && power <= 64)
-    {   /* get result from table */
-        outPow[0] = pow5_128Table[power+64].value[0];
-        outPow[1] = pow5_128Table[power+64].value[1];
-        powSize = 2;
-        exponent = pow5_128Table[power+64].exponent;
-        return;
+    // increase by 1 elem (64-bit) for accuracy
+    const cxuint extSize = maxSize+1;
+    bigFPRoundToNearest(POW5_TABLE_LIMBS, extSize, exponent, tablePow);
+    // rest of power is exact in single 64-bit value
+    const uint64_t restPow = pow5_128Table[64+rest].value[1];
+    const cxint restExp = pow5_128Table[64+rest].exponent;
+    uint64_t product[POW5_TABLE_LIMBS+2];
+    cxuint productBits;
+    bigMulFP(extSize, extSize, extSize<<6, exponent, tablePow, 1, restExp, restExp,
+             &restPow, powSize, productBits, exponent, product);
+    if (powSize == extSize)
+    {   /* round to nearest to original maxSize */
+        bigFPRoundToNearest(extSize, maxSize, exponent, product);
+        powSize = maxSize;
     }
-    
+    std::copy(product, product + powSize, outPow);
+}
+#endif
+
+/* compute big power of 5 by repeated squaring (for bigPow5) */
+static void bigPow5Compute(cxint power, cxuint maxSize, cxuint& powSize,
+            cxint& exponent, uint64_t* outPow)
+{
     maxSize++; // increase by 1 elem (64-bit) for accuracy
     const cxuint absPower = std::abs(power);
     uint64_t* heap = new uint64_t[maxSize<<3]; // four (maxSize<<1)
@@ -986,6 +1333,151 @@ static void bigPow5(cxint power, cxuint maxSize, cxuint& powSize,
     delete[] heap;
 }
 
+/*
+ * big power of 5 cache
+ * process-wide cache keyed by (power, maxSize). Reads are lock-free (slots are
+ * published by atomic pointers), filling is serialized by mutex and every key is
+ * filled only once. Memory is bounded by fixed slot table and fixed limb pool.
+ */
+
+struct BigPow5CacheEntry
+{
+    cxint power;
+    cxuint maxSize;
+    cxuint powSize;
+    cxint exponent;
+    const uint64_t* value;
+};
+
+static const cxuint BIGPOW5_CACHE_SLOTS = 1024;
+static const cxuint BIGPOW5_CACHE_PROBES = 8;
+static const size_t BIGPOW5_CACHE_POOL_SIZE = 16384; // in 64-bit limbs (128kB)
+
+static std::atomic<const BigPow5CacheEntry*> bigPow5CacheSlots[BIGPOW5_CACHE_SLOTS];
+static BigPow5CacheEntry bigPow5CacheEntries[BIGPOW5_CACHE_SLOTS];
+static uint64_t bigPow5CachePool[BIGPOW5_CACHE_POOL_SIZE];
+static size_t bigPow5CachePoolUsed = 0;
+static cxuint bigPow5CacheEntriesNum = 0;
+static std::mutex bigPow5CacheMutex;
+static std::atomic<uint64_t> bigPow5CacheHits(0);
+static std::atomic<uint64_t> bigPow5CacheMisses(0);
+
+static inline cxuint bigPow5CacheHash(cxint power, cxuint maxSize)
+{
+    const uint32_t h = (uint32_t(power)*2654435761U) ^ (uint32_t(maxSize)*40503U);
+    return (h ^ (h>>16)) & (BIGPOW5_CACHE_SLOTS-1);
+}
+
+static bool bigPow5CacheGet(cxint power, cxuint maxSize, cxuint& powSize,
+            cxint& exponent, uint64_t* outPow)
+{
+    const cxuint hash = bigPow5CacheHash(power, maxSize);
+    for (cxuint i = 0; i < BIGPOW5_CACHE_PROBES; i++)
+    {
+        const BigPow5CacheEntry* entry = bigPow5CacheSlots[
+                (hash+i) & (BIGPOW5_CACHE_SLOTS-1)].load(std::memory_order_acquire);
+        if (entry == nullptr)
+            break; // not found
+        if (entry->power == power && entry->maxSize == maxSize)
+        {
+            powSize = entry->powSize;
+            exponent = entry->exponent;
+            std::copy(entry->value, entry->value + powSize, outPow);
+            bigPow5CacheHits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    bigPow5CacheMisses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+static void bigPow5CachePut(cxint power, cxuint maxSize, cxuint powSize,
+            cxint exponent, const uint64_t* pow)
+{
+    std::lock_guard<std::mutex> lock(bigPow5CacheMutex);
+    if (bigPow5CachePoolUsed + powSize > BIGPOW5_CACHE_POOL_SIZE)
+        return; // cache is full
+    const cxuint hash = bigPow5CacheHash(power, maxSize);
+    for (cxuint i = 0; i < BIGPOW5_CACHE_PROBES; i++)
+    {
+        std::atomic<const BigPow5CacheEntry*>& slot =
+                bigPow5CacheSlots[(hash+i) & (BIGPOW5_CACHE_SLOTS-1)];
+        const BigPow5CacheEntry* entry = slot.load(std::memory_order_relaxed);
+        if (entry != nullptr)
+        {
+            if (entry->power == power && entry->maxSize == maxSize)
+                return; // already filled by other thread
+            continue;
+        }
+        // fill new entry and publish it
+        uint64_t* value = bigPow5CachePool + bigPow5CachePoolUsed;
+        std::copy(pow, pow + powSize, value);
+        bigPow5CachePoolUsed += powSize;
+        BigPow5CacheEntry* newEntry = bigPow5CacheEntries + bigPow5CacheEntriesNum++;
+        newEntry->power = power;
+        newEntry->maxSize = maxSize;
+        newEntry->powSize = powSize;
+        newEntry->exponent = exponent;
+        newEntry->value = value;
+        slot.store(newEntry, std::memory_order_release);
+        return;
+    }
+    // no free slot in probe sequence, do not cache
+}
+
+BigPow5CacheStats CLRX::getBigPow5CacheStats()
+{
+    BigPow5CacheStats stats;
+    stats.hits = bigPow5CacheHits.load(std::memory_order_relaxed);
+    stats.misses = bigPow5CacheMisses.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(bigPow5CacheMutex);
+    stats.entries = bigPow5CacheEntriesNum;
+    stats.usedLimbs = bigPow5CachePoolUsed;
+    return stats;
+}
+
+/* generate bit Power of 5.
+ * power - power, maxSize - max size of number
+ * outSize - size of output number
+ * exponent - output number exponent
+ * outPow - output number
+ * Number in format: (1 + outNumber/2**(dstsize*64)) * 2**exponent
+ */
+static void bigPow5(cxint power, cxuint maxSize, cxuint& powSize,
+            cxint& exponent, uint64_t* outPow)
+{
+    if ((power >= 0 && power < 28) ||
+        (maxSize == 1 && power >= -64 && power <= 64))
+    {   /* get result from table */
+        outPow[0] = pow5_128Table[power+64].value[1] +
+                (pow5_128Table[power+64].value[0]>>63);
+        powSize = 1;
+        exponent = pow5_128Table[power+64].exponent;
+        return;
+    }
+    if (maxSize == 2 && power >= -64 && power <= 64)
+    {   /* get result from table */
+        outPow[0] = pow5_128Table[power+64].value[0];
+        outPow[1] = pow5_128Table[power+64].value[1];
+        powSize = 2;
+        exponent = pow5_128Table[power+64].exponent;
+        return;
+    }
+    
+#ifdef HAVE_POW5_TABLES
+    if (maxSize+1 < POW5_TABLE_LIMBS && power >= POW5_TABLE_MIN_POWER &&
+        power < POW5_TABLE_MAX_POWER)
+    {   /* get result from extended precision table */
+        bigPow5FromTable(power, maxSize, powSize, exponent, outPow);
+        return;
+    }
+#endif
+    if (bigPow5CacheGet(power, maxSize, powSize, exponent, outPow))
+        return;
+    bigPow5Compute(power, maxSize, powSize, exponent, outPow);
+    bigPow5CachePut(power, maxSize, powSize, exponent, outPow);
+}
+
 /*
  * cstrtofXCStyle
  */
@@ -1032,54 +1524,265 @@ static const uint64_t power10sTable[20] =
     10000000000000000000ULL
 };
 
-#ifdef CSTRTOFX_DUMP_IRRESULTS
-static void dumpIntermediateResults(cxuint bigSize, const uint64_t* bigValue,
-        const uint64_t* bigRescaled, cxint binaryExp, cxint powerof5, cxuint maxDigits,
-        cxuint rescaledValueBits, cxuint processedDigits, cxint mantSignifBits)
+/* decimal digit pairs "00".."99" for formatting */
+static const char digitPairsTable[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* number of decimal digits of nonzero value (log10(2) ~ 1233/4096) */
+static inline cxuint u64DecDigitsNum(uint64_t value)
 {
-    std::ostringstream oss;
-    oss << "DEBUG: Dump of InterResults for cstrtof:\n";
-    oss << "PowerOf5: " << powerof5 << ", binaryExp: " << binaryExp <<
-            ", maxDigits: " << maxDigits << ", bigSize: " << bigSize <<
-            "\nrvBits: " << rescaledValueBits <<
-            ", processedDigits: " << processedDigits <<
-            ", mantSignifBits: " << mantSignifBits << "\n";
-    oss << "BigValue: ";
-    for (cxuint i = 0; i < bigSize; i++)
-        oss << std::hex << std::setw(16) << std::setfill('0') << bigValue[bigSize-i-1];
-    oss << "\nBigRescaled: ";
-    for (cxuint i = 0; i < bigSize; i++)
-        oss << std::hex << std::setw(16) << std::setfill('0') << bigRescaled[bigSize-i-1];
-    oss << "\n";
-    oss.flush();
-    std::cout << oss.str() << std::endl;
+    const cxuint bitsNum = 64 - CLZ64(value);
+    const cxuint digitsNum = (bitsNum*1233)>>12;
+    return digitsNum + (value >= power10sTable[digitsNum]);
 }
-#endif
 
-static uint64_t cstrtofXCStyle(const char* str, const char* inend,
-             const char*& outend, cxuint expBits, cxuint mantisaBits)
+/* write digitsNum decimal digits of value to out (at their final positions),
+ * generates two digits per division */
+static inline void u64WriteDecDigits(uint64_t value, cxuint digitsNum, char* out)
 {
-    uint64_t out = 0;
-    const char* p = 0;
-    bool signOfValue = false;
-    
-    if (inend == str)
-        throw ParseException("No characters to parse");
-    
-    p = str;
-    if (p+1 != inend && (*p == '+' || *p == '-'))
+    char* p = out + digitsNum;
+    for (; value > UINT32_MAX; p -= 2)
     {
-        signOfValue = (*p == '-'); // true if negative
-        p++;
+        const uint64_t tmp = value/100U;
+        const cxuint pair = cxuint(value - tmp*100U)<<1;
+        p[-2] = digitPairsTable[pair];
+        p[-1] = digitPairsTable[pair+1];
+        value = tmp;
     }
-    
-    // check for nan or inf
-    if (signOfValue) // sign
-        out = (1ULL<<(expBits + mantisaBits));
-    if (p != inend && p+1 != inend && p+2 != inend)
+    uint32_t value32 = value; // for speed
+    for (; value32 >= 100; p -= 2)
     {
-        if ((p[0] == 'n' || p[0] == 'N') && (p[1] == 'a' || p[1] == 'A') &&
-            (p[2] == 'n' || p[2] == 'N'))
+        const uint32_t tmp = value32/100U;
+        const cxuint pair = (value32 - tmp*100U)<<1;
+        p[-2] = digitPairsTable[pair];
+        p[-1] = digitPairsTable[pair+1];
+        value32 = tmp;
+    }
+    if (value32 >= 10)
+    {
+        p[-2] = digitPairsTable[value32<<1];
+        p[-1] = digitPairsTable[(value32<<1)+1];
+    }
+    else
+        p[-1] = '0' + value32;
+}
+
+#ifdef HAVE_SSE2
+/* SSE2 conversion of 8-digit numbers to decimal digits (every digit in 16-bit lane).
+ * value is split to two 4-digit parts (abcd, efgh), and any part is divided by
+ * 1000, 100, 10 and 1 by multiply-high (exact for values lower than 10000) */
+static const uint16_t sse2Div10000Pows[8] __attribute__((aligned(16))) =
+{ 8389, 5243, 13108, 32768, 8389, 5243, 13108, 32768 };
+static const uint16_t sse2Div10000Shifts[8] __attribute__((aligned(16))) =
+{ 1U<<7, 1U<<11, 1U<<13, 1U<<15, 1U<<7, 1U<<11, 1U<<13, 1U<<15 };
+
+static inline __m128i u32Convert8DigitsSSE2(uint32_t value)
+{
+    const __m128i abcdefgh = _mm_cvtsi32_si128(value);
+    // abcd = abcdefgh/10000 (0xd1b71759 = ceil(2**45/10000))
+    const __m128i abcd = _mm_srli_epi64(_mm_mul_epu32(abcdefgh,
+                _mm_set1_epi32(0xd1b71759)), 45);
+    const __m128i efgh = _mm_sub_epi32(abcdefgh, _mm_mul_epu32(abcd,
+                _mm_set1_epi32(10000)));
+    // [abcd*4, efgh*4, 0, ...] and broadcast: [abcd*4 x 4, efgh*4 x 4]
+    const __m128i v1 = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+    const __m128i v2a = _mm_unpacklo_epi16(v1, v1);
+    const __m128i v2 = _mm_unpacklo_epi32(v2a, v2a);
+    // [a, ab, abc, abcd, e, ef, efg, efgh]
+    const __m128i v3 = _mm_mulhi_epu16(v2, *(const __m128i*)sse2Div10000Pows);
+    const __m128i v4 = _mm_mulhi_epu16(v3, *(const __m128i*)sse2Div10000Shifts);
+    // subtract [0, a0, ab0, abc0, 0, e0, ef0, efg0] to get [a, b, c, d, e, f, g, h]
+    const __m128i v5 = _mm_mullo_epi16(v4, _mm_set1_epi16(10));
+    return _mm_sub_epi16(v4, _mm_slli_epi64(v5, 16));
+}
+
+/* write 16 decimal digits (with leading zeroes) of value (lower than 10**16) */
+static inline void u64Write16DecDigitsSSE2(uint64_t value, char* out)
+{
+    const uint64_t hi = value / 100000000U;
+    const uint32_t lo = value - hi*100000000U;
+    const __m128i digits = _mm_packus_epi16(u32Convert8DigitsSSE2(hi),
+                u32Convert8DigitsSSE2(lo));
+    _mm_storeu_si128((__m128i*)out, _mm_add_epi8(digits, _mm_set1_epi8('0')));
+}
+
+/* write digitsNum decimal digits of value to out (at their final positions),
+ * uses SSE2 for last 16 digits (if value has at least 9 digits) */
+static inline void u64WriteDecDigitsSSE2(uint64_t value, cxuint digitsNum, char* out)
+{
+    if (digitsNum <= 8)
+        u64WriteDecDigits(value, digitsNum, out);
+    else if (digitsNum <= 16)
+    {
+        char buffer[16];
+        u64Write16DecDigitsSSE2(value, buffer);
+        ::memcpy(out, buffer + 16-digitsNum, digitsNum);
+    }
+    else
+    {   // first 1-4 digits are written by scalar code
+        const uint64_t top = value / 10000000000000000ULL;
+        u64WriteDecDigits(top, digitsNum-16, out);
+        u64Write16DecDigitsSSE2(value - top*10000000000000000ULL, out + digitsNum-16);
+    }
+}
+#endif
+
+/* octal digit pairs "00".."77" (6 bits per pair) */
+static const char octDigitPairsTable[129] =
+    "0001020304050607101112131415161720212223242526273031323334353637"
+    "4041424344454647505152535455565760616263646566677071727374757677";
+
+static const char hexDigitsTable[2][17] = { "0123456789abcdef", "0123456789ABCDEF" };
+
+/* write digitsNum octal digits of value to out (at their final positions) */
+static inline void u64WriteOctDigits(uint64_t value, cxuint digitsNum, char* out)
+{
+    char* p = out + digitsNum;
+    for (; p-out >= 2; p -= 2, value >>= 6)
+    {
+        const cxuint pair = cxuint(value&63)<<1;
+        p[-2] = octDigitPairsTable[pair];
+        p[-1] = octDigitPairsTable[pair+1];
+    }
+    if (p != out)
+        p[-1] = '0' + (value&7);
+}
+
+#ifdef HAVE_SSSE3_DISPATCH
+static bool detectSSSE3()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+}
+
+static const bool cpuHasSSSE3 = detectSSSE3();
+
+/* hexadecimal digits of nibbles by lookup in table (PSHUFB) */
+__attribute__((target("ssse3")))
+static __m128i hexDigitsSSSE3(__m128i nibbles, bool upper)
+{
+    return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)hexDigitsTable[upper]),
+                nibbles);
+}
+#endif
+
+/* write digitsNum hexadecimal digits of value to out (at their final positions) */
+static inline void u64WriteHexDigits(uint64_t value, cxuint digitsNum, char* out,
+            bool upper)
+{
+#ifdef HAVE_SSE2
+    // bytes from most significant, interleaved high and low nibbles
+    const uint64_t swapped = __builtin_bswap64(value);
+    const __m128i bytes = _mm_loadl_epi64((const __m128i*)&swapped);
+    const __m128i nibbleMask = _mm_set1_epi8(15);
+    const __m128i nibbles = _mm_unpacklo_epi8(
+            _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask),
+            _mm_and_si128(bytes, nibbleMask));
+#  ifdef __SSSE3__
+    const __m128i digits = _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i*)hexDigitsTable[upper]), nibbles);
+#  else
+    __m128i digits;
+#    ifdef HAVE_SSSE3_DISPATCH
+    if (cpuHasSSSE3)
+        digits = hexDigitsSSSE3(nibbles, upper);
+    else
+#    endif
+    {
+        const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles,
+                _mm_set1_epi8(9)), _mm_set1_epi8(upper ? 'A'-'0'-10 : 'a'-'0'-10));
+        digits = _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+    }
+#  endif
+    char buffer[16];
+    _mm_storeu_si128((__m128i*)buffer, digits);
+    ::memcpy(out, buffer + 16-digitsNum, digitsNum);
+#else
+    const char* table = hexDigitsTable[upper];
+    for (cxuint pos = digitsNum; pos > 0; pos--, value >>= 4)
+        out[pos-1] = table[value&15];
+#endif
+}
+
+/* write digitsNum binary digits of value to out (at their final positions) */
+static inline void u64WriteBinDigits(uint64_t value, cxuint digitsNum, char* out)
+{
+#ifdef HAVE_SSE2
+    // every byte (from most significant) is spread to 8 lanes and tested by bit masks
+    const uint64_t swapped = __builtin_bswap64(value);
+    const __m128i bytes = _mm_loadl_epi64((const __m128i*)&swapped);
+    const __m128i bitMasks = _mm_set_epi8(1, 2, 4, 8, 16, 32, 64, -128,
+                1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i bytes2 = _mm_unpacklo_epi8(bytes, bytes);
+    const __m128i bytes4Lo = _mm_unpacklo_epi16(bytes2, bytes2);
+    const __m128i bytes4Hi = _mm_unpackhi_epi16(bytes2, bytes2);
+    const __m128i bytes8[4] = {
+        _mm_unpacklo_epi32(bytes4Lo, bytes4Lo), _mm_unpackhi_epi32(bytes4Lo, bytes4Lo),
+        _mm_unpacklo_epi32(bytes4Hi, bytes4Hi), _mm_unpackhi_epi32(bytes4Hi, bytes4Hi) };
+    char buffer[64];
+    for (cxuint i = 0; i < 4; i++)
+    {   // '0' - (-1) for set bits
+        const __m128i bits = _mm_cmpeq_epi8(_mm_and_si128(bytes8[i], bitMasks), bitMasks);
+        _mm_storeu_si128((__m128i*)(buffer + (i<<4)),
+                _mm_sub_epi8(_mm_set1_epi8('0'), bits));
+    }
+    ::memcpy(out, buffer + 64-digitsNum, digitsNum);
+#else
+    for (cxuint pos = digitsNum; pos > 0; pos--, value >>= 1)
+        out[pos-1] = '0' + (value&1);
+#endif
+}
+
+#ifdef CSTRTOFX_DUMP_IRRESULTS
+static void dumpIntermediateResults(cxuint bigSize, const uint64_t* bigValue,
+        const uint64_t* bigRescaled, cxint binaryExp, cxint powerof5, cxuint maxDigits,
+        cxuint rescaledValueBits, cxuint processedDigits, cxint mantSignifBits)
+{
+    std::ostringstream oss;
+    oss << "DEBUG: Dump of InterResults for cstrtof:\n";
+    oss << "PowerOf5: " << powerof5 << ", binaryExp: " << binaryExp <<
+            ", maxDigits: " << maxDigits << ", bigSize: " << bigSize <<
+            "\nrvBits: " << rescaledValueBits <<
+            ", processedDigits: " << processedDigits <<
+            ", mantSignifBits: " << mantSignifBits << "\n";
+    oss << "BigValue: ";
+    for (cxuint i = 0; i < bigSize; i++)
+        oss << std::hex << std::setw(16) << std::setfill('0') << bigValue[bigSize-i-1];
+    oss << "\nBigRescaled: ";
+    for (cxuint i = 0; i < bigSize; i++)
+        oss << std::hex << std::setw(16) << std::setfill('0') << bigRescaled[bigSize-i-1];
+    oss << "\n";
+    oss.flush();
+    std::cout << oss.str() << std::endl;
+}
+#endif
+
+static uint64_t cstrtofXCStyle(const char* str, const char* inend,
+             const char*& outend, cxuint expBits, cxuint mantisaBits)
+{
+    uint64_t out = 0;
+    const char* p = 0;
+    bool signOfValue = false;
+    
+    if (inend == str)
+        throw ParseException("No characters to parse");
+    
+    p = str;
+    if (p+1 != inend && (*p == '+' || *p == '-'))
+    {
+        signOfValue = (*p == '-'); // true if negative
+        p++;
+    }
+    
+    // check for nan or inf
+    if (signOfValue) // sign
+        out = (1ULL<<(expBits + mantisaBits));
+    if (p != inend && p+1 != inend && p+2 != inend)
+    {
+        if ((p[0] == 'n' || p[0] == 'N') && (p[1] == 'a' || p[1] == 'A') &&
+            (p[2] == 'n' || p[2] == 'N'))
         {   // create positive nan
             out = (((1ULL<<expBits)-1ULL)<<mantisaBits) | (1ULL<<(mantisaBits-1));
             outend = p+3;
@@ -1487,12 +2190,12 @@ static uint64_t cstrtofXCStyle(const char* str, const char* inend,
                         }
                         uint64_t tmpPack[5];
                         // put to digitPack
-                        bigMul(1, &power10sTable[digitsOfPart], 4, digitPack, tmpPack);
+                        bigMulFixed<1, 4>(&power10sTable[digitsOfPart], digitPack, tmpPack);
                         digitPack[0] = tmpPack[0];
                         digitPack[1] = tmpPack[1];
                         digitPack[2] = tmpPack[2];
                         digitPack[3] = tmpPack[3];
-                        bigAdd(4, digitPack, 1, &curValue);
+                        bigAddFixed<4, 1>(digitPack, &curValue);
                         digitsOfPack += digitsOfPart;
                         packTens[digitPacksNum++] = power10sTable[digitsOfPart];
                     }
@@ -1503,7 +2206,7 @@ static uint64_t cstrtofXCStyle(const char* str, const char* inend,
                         uint64_t tmpProd[4];
                         mul64Full(packTens[0], packTens[1], tmpProd);
                         mul64Full(packTens[2], packTens[3], tmpProd+2);
-                        bigMulPow2(2, tmpProd, tmpProd+2, packPowerOfTen);
+                        bigMulFixed<2, 2>(tmpProd, tmpProd+2, packPowerOfTen);
                     }
                     else
                     {
@@ -1759,404 +2462,4237 @@ double CLRX::cstrtodCStyle(const char* str, const char* inend, const char*& oute
     return v.d;
 }
 
-static size_t fXtocstrCStyle(uint64_t value, char* str, size_t maxSize,
-        bool scientific, cxuint expBits, cxuint mantisaBits)
+/*
+ * resumable (incremental) parsers
+ */
+
+static inline cxint cstrHexDigit(char c)
 {
-    char* p = str;
-    bool signOfValue = ((value>>(expBits+mantisaBits))!=0);
-    const cxuint expMask = ((1U<<expBits)-1U);
-    const uint64_t mantisaMask = (1ULL<<mantisaBits)-1ULL;
-    
-    if (((value >> mantisaBits)&expMask) == expMask)
-    {   // infinity or nans
-        if (signOfValue)
+    if (c >= '0' && c <= '9')
+        return c-'0';
+    else if (c >= 'A' && c <= 'F')
+        return c-'A'+10;
+    else if (c >= 'a' && c <= 'f')
+        return c-'a'+10;
+    return -1;
+}
+
+enum : cxuint
+{
+    UINCR_START = 0,
+    UINCR_ZERO,
+    UINCR_HEX_START,
+    UINCR_BIN_START,
+    UINCR_HEX,
+    UINCR_BIN,
+    UINCR_OCT,
+    UINCR_DEC,
+    UINCR_FINISHED
+};
+
+UIntIncrParser::UIntIncrParser(cxuint _bits) : bits(_bits), state(UINCR_START), value(0)
+{ }
+
+void UIntIncrParser::reset()
+{
+    state = UINCR_START;
+    value = 0;
+}
+
+bool UIntIncrParser::isFinished() const
+{
+    return state == UINCR_FINISHED;
+}
+
+const char* UIntIncrParser::feed(const char* str, const char* inend)
+{
+    const uint64_t mask = (bits < 64) ? ((1ULL<<bits)-1) : UINT64_MAX;
+    for (const char* p = str; p != inend; p++)
+    {
+        const char c = *p;
+        cxint digit = cstrHexDigit(c);
+        switch(state)
         {
-            if (maxSize < 5)
-                throw Exception("Max size is too small");
-            *p++ = '-';
-        }
-        else if (maxSize < 4)
-            throw Exception("Max size is too small");
-        
-        if ((value&mantisaMask) != 0)
-        {   /* nan */
-            *p++ = 'n';
-            *p++ = 'a';
-            *p++ = 'n';
+            case UINCR_START:
+                if (c == '0')
+                {
+                    state = UINCR_ZERO;
+                    continue;
+                }
+                if (digit < 0 || digit > 9)
+                    throw ParseException("A missing number");
+                state = UINCR_DEC;
+                break;
+            case UINCR_ZERO:
+                if (c == 'x' || c == 'X')
+                    state = UINCR_HEX_START;
+                else if (c == 'b' || c == 'B')
+                    state = UINCR_BIN_START;
+                else if (c >= '0' && c <= '7')
+                {
+                    state = UINCR_OCT;
+                    break;
+                }
+                else
+                    state = UINCR_FINISHED;
+                if (state == UINCR_FINISHED)
+                    return p;
+                continue;
+            case UINCR_HEX_START:
+                if (digit < 0)
+                    throw ParseException("A missing number");
+                state = UINCR_HEX;
+                break;
+            case UINCR_BIN_START:
+                if (c != '0' && c != '1')
+                    throw ParseException("A missing number");
+                state = UINCR_BIN;
+                break;
+            case UINCR_FINISHED:
+                return p;
+            default:
+                break;
         }
-        else
-        {   /* infinity */
-            *p++ = 'i';
-            *p++ = 'n';
-            *p++ = 'f';
+        switch(state)
+        {
+            case UINCR_HEX:
+                if (digit < 0)
+                {
+                    state = UINCR_FINISHED;
+                    return p;
+                }
+                if ((value & (15ULL<<(bits-4))) != 0)
+                    throw ParseException("Number out of range");
+                value = (value<<4) + digit;
+                break;
+            case UINCR_BIN:
+                if (c != '0' && c != '1')
+                {
+                    state = UINCR_FINISHED;
+                    return p;
+                }
+                if ((value & (1ULL<<(bits-1))) != 0)
+                    throw ParseException("Number out of range");
+                value = (value<<1) + digit;
+                break;
+            case UINCR_OCT:
+                if (c < '0' || c > '7')
+                {
+                    state = UINCR_FINISHED;
+                    return p;
+                }
+                if ((value & (7ULL<<(bits-3))) != 0)
+                    throw ParseException("Number out of range");
+                value = (value<<3) + digit;
+                break;
+            default: // decimal
+                if (c < '0' || c > '9')
+                {
+                    state = UINCR_FINISHED;
+                    return p;
+                }
+                if (value > mask/10)
+                    throw ParseException("Number out of range");
+                value = value*10 + digit;
+                if ((value&mask) < cxuint(digit)) // if carry
+                    throw ParseException("Number out of range");
+                break;
         }
-        *p = 0;
-        return p-str;
     }
-    
-    uint64_t mantisa = value&mantisaMask;
-    const int minExpNonDenorm = -((1U<<(expBits-1))-2);
-    const int binaryExp = ((value>>mantisaBits)&expMask) - (expMask>>1);
-    
-    if (mantisa == 0 && binaryExp == minExpNonDenorm-1)
-    {   /* if zero */
-        if (signOfValue)
+    return (state == UINCR_FINISHED) ? str : inend;
+}
+
+uint64_t UIntIncrParser::finish()
+{
+    if (state == UINCR_START)
+        throw ParseException("No characters to parse");
+    if (state == UINCR_HEX_START || state == UINCR_BIN_START)
+        throw ParseException("Number is too short");
+    state = UINCR_FINISHED;
+    return value;
+}
+
+enum : cxuint
+{
+    FINCR_START = 0,
+    FINCR_SIGN,
+    FINCR_SPECIAL,
+    FINCR_ZERO,
+    FINCR_VALUE,
+    FINCR_EXP_START,
+    FINCR_EXP_SIGN,
+    FINCR_EXP_DIGITS,
+    FINCR_FINISHED
+};
+
+/* flag of infinity in specialMatched */
+static const cxuint FINCR_SPECIAL_INF = 4;
+
+FloatIncrParser::FloatIncrParser(cxuint _expBits, cxuint _mantisaBits)
+        : expBits(_expBits), mantisaBits(_mantisaBits)
+{
+    /* max significant digits of midpoint between two floating points:
+     * digits of (2*mantisa+1) * 5**(-minExpDenorm+1) */
+    const cxuint minExpDenormAbs = (1U<<(expBits-1)) - 2 + mantisaBits;
+    maxDigits = std::min(MAX_DIGITS, ((mantisaBits+2)*30103U + 99999U)/100000U +
+            ((minExpDenormAbs+1)*69898U + 99999U)/100000U + 2);
+    reset();
+}
+
+void FloatIncrParser::reset()
+{
+    state = FINCR_START;
+    negative = hex = comma = firstDigitFound = sticky = expNegative = false;
+    specialMatched = 0;
+    valueChars = 0;
+    valueExp = 0;
+    absExponent = 0;
+    digitsNum = 0;
+}
+
+bool FloatIncrParser::isFinished() const
+{
+    return state == FINCR_FINISHED;
+}
+
+void FloatIncrParser::endValue()
+{
+    if (valueChars == 0 || (valueChars == 1 && comma))
+        throw ParseException("Floating point doesn't have value part!");
+}
+
+void FloatIncrParser::endExponent()
+{
+    if (!expNegative && absExponent == (1U<<31))
+        // if abs exponent with max negative value and not negative
+        throw ParseException("Exponent out of range");
+}
+
+const char* FloatIncrParser::feed(const char* str, const char* inend)
+{
+    for (const char* p = str; p != inend; p++)
+    {
+        const char c = *p;
+        switch(state)
         {
-            if (maxSize < 3)
-                throw Exception("Max size is too small");
-            *p++ = '-';
+            case FINCR_START:
+                if (c == '+' || c == '-')
+                {
+                    negative = (c == '-');
+                    state = FINCR_SIGN;
+                    continue;
+                }
+                // fall through
+            case FINCR_SIGN:
+                if (c == '0')
+                {
+                    state = FINCR_ZERO;
+                    continue;
+                }
+                if (c == 'n' || c == 'N' || c == 'i' || c == 'I')
+                {
+                    specialMatched = (c == 'i' || c == 'I') ? FINCR_SPECIAL_INF+1 : 1;
+                    state = FINCR_SPECIAL;
+                    continue;
+                }
+                state = FINCR_VALUE;
+                break;
+            case FINCR_SPECIAL:
+            {
+                const char* word = (specialMatched >= FINCR_SPECIAL_INF) ? "inf" : "nan";
+                const cxuint matched = specialMatched & (FINCR_SPECIAL_INF-1);
+                if (c != word[matched] && c != word[matched]-'a'+'A')
+                    throw ParseException("Floating point doesn't have value part!");
+                specialMatched++;
+                if (matched+1 == 3)
+                {
+                    state = FINCR_FINISHED;
+                    return p+1;
+                }
+                continue;
+            }
+            case FINCR_ZERO:
+                state = FINCR_VALUE;
+                if (c == 'x' || c == 'X')
+                {
+                    hex = true;
+                    continue;
+                }
+                valueChars = 1; // leading zero
+                break;
+            case FINCR_EXP_START:
+                if (c == '+' || c == '-')
+                {
+                    expNegative = (c == '-');
+                    state = FINCR_EXP_SIGN;
+                    continue;
+                }
+                // fall through
+            case FINCR_EXP_SIGN:
+                if (c < '0' || c > '9')
+                    throw ParseException("Garbages at floating point exponent");
+                state = FINCR_EXP_DIGITS;
+                break;
+            case FINCR_FINISHED:
+                return p;
+            default:
+                break;
         }
-        else if (maxSize < 2)
-            throw Exception("Max size is too small");
-        *p++ = '0';
-        if (scientific)
+        
+        if (state == FINCR_EXP_DIGITS)
         {
-            if (p+3 >= str + maxSize)
-                throw Exception("Max size is too small");
-            *p++='e';
-            *p++='+';
-            *p++='0';
-        }   
-        *p = 0;
-        return p-str;
-    }
-    
-    cxuint significantBits = 0;
-    if (binaryExp >= minExpNonDenorm)
-    {   /* normalized value */
-        significantBits = mantisaBits;
-        mantisa |= 1ULL<<mantisaBits;
+            if (c < '0' || c > '9')
+            {
+                endExponent();
+                state = FINCR_FINISHED;
+                return p;
+            }
+            if (absExponent > ((1U<<31)/10))
+                throw ParseException("Exponent out of range");
+            const cxuint digit = (c-'0');
+            absExponent = absExponent * 10 + digit;
+            if ((absExponent&((1U<<31)-1)) < digit && absExponent != (1U<<31))
+                // if carry
+                throw ParseException("Exponent out of range");
+            continue;
+        }
+        
+        // value part
+        const cxint digit = cstrHexDigit(c);
+        if (digit < 0 || (!hex && digit > 9))
+        {
+            if (c == '.' && !comma)
+            {
+                comma = true;
+                valueChars++;
+                continue;
+            }
+            endValue();
+            if ((!hex && (c == 'e' || c == 'E')) || (hex && (c == 'p' || c == 'P')))
+            {
+                state = FINCR_EXP_START;
+                continue;
+            }
+            state = FINCR_FINISHED;
+            return p;
+        }
+        valueChars++;
+        const cxuint step = (hex) ? 4 : 1;
+        if (!firstDigitFound)
+        {
+            if (comma)
+                valueExp -= step;
+            if (digit == 0)
+                continue; // skip zeroes
+            firstDigitFound = true;
+        }
+        else if (!comma)
+            valueExp += step;
+        if (digitsNum < maxDigits)
+            digits[digitsNum++] = c;
+        else if (digit != 0)
+            sticky = true;
     }
-    else /* if value is denormalized */
+    return (state == FINCR_FINISHED) ? str : inend;
+}
+
+uint64_t FloatIncrParser::finish()
+{
+    switch(state)
+    {
+        case FINCR_START:
+            throw ParseException("No characters to parse");
+        case FINCR_SIGN:
+        case FINCR_SPECIAL:
+            throw ParseException("Floating point doesn't have value part!");
+        case FINCR_VALUE:
+            endValue();
+            break;
+        case FINCR_EXP_START:
+        case FINCR_EXP_SIGN:
+            throw ParseException("End of floating point at exponent");
+        case FINCR_EXP_DIGITS:
+            endExponent();
+            break;
+        default:
+            break;
+    }
+    state = FINCR_FINISHED;
+    /* build normalized number (first digit, dot, significant digits, sticky digit
+     * and exponent) and parse it by cstrtofXCStyle */
+    char buffer[MAX_DIGITS+40];
+    char* p = buffer;
+    if (negative)
+        *p++ = '-';
+    if (specialMatched != 0)
+    {
+        ::memcpy(p, (specialMatched >= FINCR_SPECIAL_INF) ? "inf" : "nan", 3);
+        p += 3;
+    }
+    else
+    {
+        const int64_t exponent = valueExp + ((expNegative) ? -int64_t(absExponent) :
+                int64_t(absExponent));
+        if (digitsNum == 0 || exponent < -(1LL<<30))
+            *p++ = '0';
+        else if (exponent > (1LL<<30))
+            throw ParseException("Absolute value of number is too big");
+        else
+        {
+            if (hex)
+            {
+                *p++ = '0';
+                *p++ = 'x';
+            }
+            *p++ = digits[0];
+            if (digitsNum > 1 || sticky)
+                *p++ = '.';
+            ::memcpy(p, digits+1, digitsNum-1);
+            p += digitsNum-1;
+            if (sticky)
+                *p++ = '1';
+            *p++ = (hex) ? 'p' : 'e';
+            if (exponent < 0)
+                *p++ = '-';
+            p += u64tocstrCStyle((exponent < 0) ? -exponent : exponent, p, 16);
+        }
+    }
+    const char* outend;
+    return cstrtofXCStyle(buffer, p, outend, expBits, mantisaBits);
+}
+
+/*
+ * parsing of segmented strings
+ */
+
+/* returns true if any segment after segment i is not empty */
+static inline bool hasNextSegmentChars(size_t segmentsNum, const CStrSegment* segments,
+            size_t i)
+{
+    for (i++; i < segmentsNum; i++)
+        if (segments[i].str != segments[i].inend)
+            return true;
+    return false;
+}
+
+/* fast path: parse number that ends inside first segment.
+ * returns false if number can be continued in next segments */
+template<typename T>
+static bool cstrtoXFirstSegmentCStyle(size_t segmentsNum, const CStrSegment* segments,
+            CStrSegmentPos& outpos, T (*parseElem)(const char*, const char*, const char*&),
+            T& value)
+{
+    if (segmentsNum == 0)
+        throw ParseException("No characters to parse");
+    const char* outend;
+    try
+    {
+        value = parseElem(segments[0].str, segments[0].inend, outend);
+    }
+    catch(const ParseException& ex)
+    {
+        if (!hasNextSegmentChars(segmentsNum, segments, 0))
+            throw;
+        return false;
+    }
+    if (outend != segments[0].inend || !hasNextSegmentChars(segmentsNum, segments, 0))
+    {
+        outpos = { 0, outend };
+        return true;
+    }
+    return false;
+}
+
+/* slow path: feed resumable parser by segments (number spans segments) */
+template<typename IncrParser>
+static uint64_t cstrtoXSpanSegmentsCStyle(size_t segmentsNum, const CStrSegment* segments,
+            CStrSegmentPos& outpos, IncrParser& parser)
+{
+    outpos = { segmentsNum-1, segments[segmentsNum-1].inend };
+    for (size_t i = 0; i < segmentsNum; i++)
+    {
+        const char* end = parser.feed(segments[i].str, segments[i].inend);
+        if (parser.isFinished())
+        {
+            outpos = { i, end };
+            break;
+        }
+    }
+    return parser.finish();
+}
+
+uint32_t CLRX::cstrtou32SegmentsCStyle(size_t segmentsNum, const CStrSegment* segments,
+            CStrSegmentPos& outpos)
+{
+    uint32_t value;
+    if (cstrtoXFirstSegmentCStyle(segmentsNum, segments, outpos, cstrtou32CStyle, value))
+        return value;
+    UIntIncrParser parser(32);
+    return cstrtoXSpanSegmentsCStyle(segmentsNum, segments, outpos, parser);
+}
+
+uint64_t CLRX::cstrtou64SegmentsCStyle(size_t segmentsNum, const CStrSegment* segments,
+            CStrSegmentPos& outpos)
+{
+    uint64_t value;
+    if (cstrtoXFirstSegmentCStyle(segmentsNum, segments, outpos, cstrtou64CStyle, value))
+        return value;
+    UIntIncrParser parser(64);
+    return cstrtoXSpanSegmentsCStyle(segmentsNum, segments, outpos, parser);
+}
+
+cxushort CLRX::cstrtohSegmentsCStyle(size_t segmentsNum, const CStrSegment* segments,
+            CStrSegmentPos& outpos)
+{
+    cxushort value;
+    if (cstrtoXFirstSegmentCStyle(segmentsNum, segments, outpos, cstrtohCStyle, value))
+        return value;
+    FloatIncrParser parser(5, 10);
+    return cstrtoXSpanSegmentsCStyle(segmentsNum, segments, outpos, parser);
+}
+
+float CLRX::cstrtofSegmentsCStyle(size_t segmentsNum, const CStrSegment* segments,
+            CStrSegmentPos& outpos)
+{
+    FloatUnion v;
+    if (cstrtoXFirstSegmentCStyle(segmentsNum, segments, outpos, cstrtofCStyle, v.f))
+        return v.f;
+    FloatIncrParser parser(8, 23);
+    v.u = cstrtoXSpanSegmentsCStyle(segmentsNum, segments, outpos, parser);
+    return v.f;
+}
+
+double CLRX::cstrtodSegmentsCStyle(size_t segmentsNum, const CStrSegment* segments,
+            CStrSegmentPos& outpos)
+{
+    DoubleUnion v;
+    if (cstrtoXFirstSegmentCStyle(segmentsNum, segments, outpos, cstrtodCStyle, v.d))
+        return v.d;
+    FloatIncrParser parser(11, 52);
+    v.u = cstrtoXSpanSegmentsCStyle(segmentsNum, segments, outpos, parser);
+    return v.d;
+}
+
+/*
+ * parsing of strings of wide characters
+ */
+
+/* number of code units narrowed at once (longer numbers are parsed by
+ * resumable parsers) */
+static const size_t WIDE_BLOCK_SIZE = 32;
+
+/* narrow code units to chars, code units above 0xff are replaced by 0xff
+ * (numbers consist only ASCII characters) */
+template<typename CharType>
+static inline void narrowCodeUnits(size_t n, const CharType* in, char* out)
+{
+    size_t i = 0;
+#ifdef HAVE_SSE2
+    if (sizeof(CharType) == 2)
+    {
+        const __m128i minusFF = _mm_set1_epi16(-0x100);
+        for (; i+16 <= n; i += 16)
+        {   // unsigned min(v, 0xff) by saturated add and subtract
+            __m128i v0 = _mm_loadu_si128((const __m128i*)(in+i));
+            __m128i v1 = _mm_loadu_si128((const __m128i*)(in+i+8));
+            v0 = _mm_sub_epi16(_mm_adds_epu16(v0, minusFF), minusFF);
+            v1 = _mm_sub_epi16(_mm_adds_epu16(v1, minusFF), minusFF);
+            _mm_storeu_si128((__m128i*)(out+i), _mm_packus_epi16(v0, v1));
+        }
+    }
+    else if (sizeof(CharType) == 4)
+    {
+        const __m128i ff = _mm_set1_epi32(0xff);
+        const __m128i zero = _mm_setzero_si128();
+        for (; i+16 <= n; i += 16)
+        {
+            __m128i v[4];
+            for (cxuint k = 0; k < 4; k++)
+            {   // replace values above 0xff (and negative) by 0xff
+                v[k] = _mm_loadu_si128((const __m128i*)(in+i+k*4));
+                const __m128i mask = _mm_or_si128(_mm_cmpgt_epi32(v[k], ff),
+                            _mm_cmplt_epi32(v[k], zero));
+                v[k] = _mm_or_si128(_mm_andnot_si128(mask, v[k]),
+                            _mm_and_si128(mask, ff));
+            }
+            _mm_storeu_si128((__m128i*)(out+i), _mm_packus_epi16(
+                    _mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3])));
+        }
+    }
+#endif
+    for (; i < n; i++)
+    {
+        const uint32_t c = uint32_t(in[i]);
+        out[i] = (c <= 0xff) ? char(c) : char(0xff);
+    }
+}
+
+/* fast path: narrow first block and parse number if it ends in block.
+ * returns false if number can be continued after block */
+template<typename T, typename CharType>
+static bool cstrtoXFirstBlockCStyle(const CharType* str, const CharType* inend,
+            const CharType*& outend, T (*parseElem)(const char*, const char*, const char*&),
+            T& value)
+{
+    char buffer[WIDE_BLOCK_SIZE];
+    const size_t n = std::min(size_t(inend-str), WIDE_BLOCK_SIZE);
+    narrowCodeUnits(n, str, buffer);
+    const char* end;
+    try
+    {
+        value = parseElem(buffer, buffer+n, end);
+    }
+    catch(const ParseException& ex)
+    {
+        if (str+n == inend)
+            throw;
+        return false;
+    }
+    if (end != buffer+n || str+n == inend)
+    {
+        outend = str + (end-buffer);
+        return true;
+    }
+    return false;
+}
+
+/* slow path: feed resumable parser by narrowed blocks */
+template<typename CharType, typename IncrParser>
+static uint64_t cstrtoXWideBlocksCStyle(const CharType* str, const CharType* inend,
+            const CharType*& outend, IncrParser& parser)
+{
+    char buffer[WIDE_BLOCK_SIZE];
+    outend = inend;
+    while (str != inend)
+    {
+        const size_t n = std::min(size_t(inend-str), WIDE_BLOCK_SIZE);
+        narrowCodeUnits(n, str, buffer);
+        const char* end = parser.feed(buffer, buffer+n);
+        if (parser.isFinished())
+        {
+            outend = str + (end-buffer);
+            break;
+        }
+        str += n;
+    }
+    return parser.finish();
+}
+
+template<typename CharType>
+uint32_t CLRX::cstrtou32WideCStyle(const CharType* str, const CharType* inend,
+            const CharType*& outend)
+{
+    uint32_t value;
+    if (cstrtoXFirstBlockCStyle(str, inend, outend, cstrtou32CStyle, value))
+        return value;
+    UIntIncrParser parser(32);
+    return cstrtoXWideBlocksCStyle(str, inend, outend, parser);
+}
+
+template<typename CharType>
+uint64_t CLRX::cstrtou64WideCStyle(const CharType* str, const CharType* inend,
+            const CharType*& outend)
+{
+    uint64_t value;
+    if (cstrtoXFirstBlockCStyle(str, inend, outend, cstrtou64CStyle, value))
+        return value;
+    UIntIncrParser parser(64);
+    return cstrtoXWideBlocksCStyle(str, inend, outend, parser);
+}
+
+template<typename CharType>
+cxushort CLRX::cstrtohWideCStyle(const CharType* str, const CharType* inend,
+            const CharType*& outend)
+{
+    cxushort value;
+    if (cstrtoXFirstBlockCStyle(str, inend, outend, cstrtohCStyle, value))
+        return value;
+    FloatIncrParser parser(5, 10);
+    return cstrtoXWideBlocksCStyle(str, inend, outend, parser);
+}
+
+template<typename CharType>
+float CLRX::cstrtofWideCStyle(const CharType* str, const CharType* inend,
+            const CharType*& outend)
+{
+    FloatUnion v;
+    if (cstrtoXFirstBlockCStyle(str, inend, outend, cstrtofCStyle, v.f))
+        return v.f;
+    FloatIncrParser parser(8, 23);
+    v.u = cstrtoXWideBlocksCStyle(str, inend, outend, parser);
+    return v.f;
+}
+
+template<typename CharType>
+double CLRX::cstrtodWideCStyle(const CharType* str, const CharType* inend,
+            const CharType*& outend)
+{
+    DoubleUnion v;
+    if (cstrtoXFirstBlockCStyle(str, inend, outend, cstrtodCStyle, v.d))
+        return v.d;
+    FloatIncrParser parser(11, 52);
+    v.u = cstrtoXWideBlocksCStyle(str, inend, outend, parser);
+    return v.d;
+}
+
+template uint32_t CLRX::cstrtou32WideCStyle<char16_t>(const char16_t* str,
+            const char16_t* inend, const char16_t*& outend);
+template uint32_t CLRX::cstrtou32WideCStyle<char32_t>(const char32_t* str,
+            const char32_t* inend, const char32_t*& outend);
+template uint32_t CLRX::cstrtou32WideCStyle<wchar_t>(const wchar_t* str,
+            const wchar_t* inend, const wchar_t*& outend);
+template uint64_t CLRX::cstrtou64WideCStyle<char16_t>(const char16_t* str,
+            const char16_t* inend, const char16_t*& outend);
+template uint64_t CLRX::cstrtou64WideCStyle<char32_t>(const char32_t* str,
+            const char32_t* inend, const char32_t*& outend);
+template uint64_t CLRX::cstrtou64WideCStyle<wchar_t>(const wchar_t* str,
+            const wchar_t* inend, const wchar_t*& outend);
+template cxushort CLRX::cstrtohWideCStyle<char16_t>(const char16_t* str,
+            const char16_t* inend, const char16_t*& outend);
+template cxushort CLRX::cstrtohWideCStyle<char32_t>(const char32_t* str,
+            const char32_t* inend, const char32_t*& outend);
+template cxushort CLRX::cstrtohWideCStyle<wchar_t>(const wchar_t* str,
+            const wchar_t* inend, const wchar_t*& outend);
+template float CLRX::cstrtofWideCStyle<char16_t>(const char16_t* str,
+            const char16_t* inend, const char16_t*& outend);
+template float CLRX::cstrtofWideCStyle<char32_t>(const char32_t* str,
+            const char32_t* inend, const char32_t*& outend);
+template float CLRX::cstrtofWideCStyle<wchar_t>(const wchar_t* str,
+            const wchar_t* inend, const wchar_t*& outend);
+template double CLRX::cstrtodWideCStyle<char16_t>(const char16_t* str,
+            const char16_t* inend, const char16_t*& outend);
+template double CLRX::cstrtodWideCStyle<char32_t>(const char32_t* str,
+            const char32_t* inend, const char32_t*& outend);
+template double CLRX::cstrtodWideCStyle<wchar_t>(const wchar_t* str,
+            const wchar_t* inend, const wchar_t*& outend);
+
+/*
+ * cstrtobigCStyle
+ */
+
+/* parse digits in power of two radix (bitsPerDigit - 1, 3 or 4) directly to limbs */
+static const char* cstrtobigPow2Radix(const char* str, const char* inend,
+            cxuint bitsPerDigit, cxuint size, uint64_t* bigNum)
+{
+    const cxint maxDigit = (1<<bitsPerDigit)-1;
+    const char* p = str;
+    for (; p != inend; p++)
+    {
+        const cxint digit = cstrHexDigit(*p);
+        if (digit < 0 || digit > maxDigit)
+            break;
+    }
+    const char* digitsEnd = p;
+    // skip leading zeroes
+    const char* vs = str;
+    while (vs != digitsEnd && *vs == '0') vs++;
+    std::fill(bigNum, bigNum+size, uint64_t(0));
+    if (vs == digitsEnd)
+        return digitsEnd; // zero
+    
+    const uint64_t bits = uint64_t(64-CLZ64(cstrHexDigit(*vs))) +
+            uint64_t(digitsEnd-vs-1)*bitsPerDigit;
+    if (bits > (uint64_t(size)<<6))
+        throw ParseException("Number out of range");
+    
+    uint64_t bitPos = 0;
+    for (p = digitsEnd; p != vs; bitPos += bitsPerDigit)
+    {
+        const uint64_t digit = cstrHexDigit(*--p);
+        const cxuint shift = bitPos&63;
+        bigNum[bitPos>>6] |= digit<<shift;
+        if (shift + bitsPerDigit > 64 && (digit>>(64-shift)) != 0)
+            bigNum[(bitPos>>6)+1] |= digit>>(64-shift);
+    }
+    return digitsEnd;
+}
+
+/* minimal number of 19-digit chunks to use divide-and-conquer conversion */
+static const cxuint CSTRTOBIG_DIVCONQ_CHUNKS = 16;
+
+/* parse 19-digit chunk (or shorter) */
+static inline uint64_t cstrtobigDecChunk(const char* p, const char* end)
+{
+    uint64_t value = 0;
+    for (; p != end; p++)
+        value = value*10 + (*p-'0');
+    return value;
+}
+
+/* parse decimal digits, uses divide-and-conquer for long numbers */
+static const char* cstrtobigDecimal(const char* str, const char* inend,
+            cxuint size, uint64_t* bigNum)
+{
+    const char* p = str;
+    for (; p != inend && *p >= '0' && *p <= '9'; p++);
+    if (p == str)
+        throw ParseException("A missing number");
+    const char* digitsEnd = p;
+    const char* vs = str;
+    while (vs != digitsEnd && *vs == '0') vs++;
+    std::fill(bigNum, bigNum+size, uint64_t(0));
+    if (vs == digitsEnd)
+        return digitsEnd; // zero
+    
+    const size_t digitsNum = digitsEnd-vs;
+    // quick range check (log10(2**64) = 19.27)
+    if (digitsNum > size_t(size)*20)
+        throw ParseException("Number out of range");
+    const size_t chunksNum = (digitsNum+18)/19;
+    const cxuint firstChunkDigits = digitsNum - (chunksNum-1)*19;
+    
+    if (chunksNum < CSTRTOBIG_DIVCONQ_CHUNKS)
+    {   /* simple conversion: value = value*10**19 + chunk */
+        cxuint valueSize = 1;
+        bigNum[0] = cstrtobigDecChunk(vs, vs+firstChunkDigits);
+        for (const char* cp = vs+firstChunkDigits; cp != digitsEnd; cp += 19)
+        {
+            uint64_t carry = cstrtobigDecChunk(cp, cp+19);
+            for (cxuint i = 0; i < valueSize; i++)
+            {
+                uint64_t t[2];
+                mul64Full(bigNum[i], power10sTable[19], t);
+                bigNum[i] = t[0] + carry;
+                carry = t[1] + (bigNum[i] < carry);
+            }
+            if (carry != 0)
+            {
+                if (valueSize == size)
+                    throw ParseException("Number out of range");
+                bigNum[valueSize++] = carry;
+            }
+        }
+        return digitsEnd;
+    }
+    
+    /* divide-and-conquer: at level k groups of 2**k chunks (aligned from least
+     * significant chunk) are combined: group = high*10**(19*2**k) + low */
+    cxuint levelsNum = 0;
+    while ((size_t(1)<<levelsNum) < chunksNum)
+        levelsNum++;
+    // powers 10**(19*2**k) for k < levelsNum (sizes are not greater than 2**k)
+    std::vector<cxuint> powSizes(levelsNum);
+    std::vector<size_t> powOffsets(levelsNum);
+    size_t powsTotal = 0;
+    for (cxuint k = 0; k < levelsNum; k++)
+    {
+        powOffsets[k] = powsTotal;
+        powsTotal += (size_t(1)<<k);
+    }
+    // using vector for prevents memory leaks (function can throw exception)
+    std::vector<uint64_t> heap(powsTotal + chunksNum + chunksNum + 1);
+    uint64_t* pows = heap.data();
+    uint64_t* work = heap.data() + powsTotal;
+    uint64_t* tmpMul = heap.data() + powsTotal + chunksNum;
+    
+    pows[0] = power10sTable[19];
+    powSizes[0] = 1;
+    for (cxuint k = 1; k < levelsNum; k++)
+    {
+        const cxuint prevSize = powSizes[k-1];
+        uint64_t* prevPow = pows + powOffsets[k-1];
+        bigMul(prevSize, prevPow, prevSize, prevPow, pows + powOffsets[k]);
+        powSizes[k] = (prevSize<<1) - (pows[powOffsets[k] + (prevSize<<1)-1] == 0);
+    }
+    
+    // level 0: chunks in little endian order
+    {
+        work[chunksNum-1] = cstrtobigDecChunk(vs, vs+firstChunkDigits);
+        const char* cp = vs+firstChunkDigits;
+        for (size_t i = chunksNum-1; i > 0; i--, cp += 19)
+            work[i-1] = cstrtobigDecChunk(cp, cp+19);
+    }
+    
+    for (cxuint k = 0; k < levelsNum; k++)
+    {
+        const size_t groupSize = size_t(1)<<k;
+        const uint64_t* curPow = pows + powOffsets[k];
+        const cxuint curPowSize = powSizes[k];
+        for (size_t lowPos = 0; lowPos + groupSize < chunksNum; lowPos += groupSize<<1)
+        {
+            uint64_t* low = work + lowPos;
+            uint64_t* high = low + groupSize;
+            const size_t highSize = std::min(groupSize, chunksNum - lowPos - groupSize);
+            // high*10**(19*2**k) + low
+            bigMul(highSize, high, curPowSize, curPow, tmpMul);
+            const size_t groupSize2 = groupSize + highSize;
+            std::fill(tmpMul + highSize + curPowSize, tmpMul + groupSize2, uint64_t(0));
+            bigAdd(groupSize2, tmpMul, groupSize, low);
+            std::copy(tmpMul, tmpMul + groupSize2, low);
+        }
+    }
+    
+    for (size_t i = size; i < chunksNum; i++)
+        if (work[i] != 0)
+            throw ParseException("Number out of range");
+    std::copy(work, work + std::min(size_t(size), chunksNum), bigNum);
+    return digitsEnd;
+}
+
+void CLRX::cstrtobigCStyle(const char* str, const char* inend, const char*& outend,
+            cxuint size, uint64_t* bigNum)
+{
+    if (inend == str)
+        throw ParseException("No characters to parse");
+    
+    const char* p;
+    if (*str == '0')
+    {
+        if (inend != str+1 && (str[1] == 'x' || str[1] == 'X'))
+        {   // hex
+            if (inend == str+2)
+                throw ParseException("Number is too short");
+            p = cstrtobigPow2Radix(str+2, inend, 4, size, bigNum);
+            if (p == str+2)
+                throw ParseException("A missing number");
+        }
+        else if (inend != str+1 && (str[1] == 'b' || str[1] == 'B'))
+        {   // binary
+            if (inend == str+2)
+                throw ParseException("Number is too short");
+            p = cstrtobigPow2Radix(str+2, inend, 1, size, bigNum);
+            if (p == str+2)
+                throw ParseException("A missing number");
+        }
+        else // octal (if no octal parsed, then zero)
+            p = cstrtobigPow2Radix(str+1, inend, 3, size, bigNum);
+    }
+    else // decimal
+        p = cstrtobigDecimal(str, inend, size, bigNum);
+    outend = p;
+}
+
+/* parse decimal 128-bit number: 19-digit chunks combined by 64x64->128 multiplication */
+static const char* cstrtou128Decimal(const char* str, const char* inend, uint64_t* value)
+{
+    const char* p = str;
+    value[0] = value[1] = 0;
+    while (p != inend && *p >= '0' && *p <= '9')
+    {
+        const char* chunkEnd = p;
+        uint64_t chunk = 0;
+        for (; chunkEnd != inend && chunkEnd-p < 19 && *chunkEnd >= '0' && *chunkEnd <= '9';
+             chunkEnd++)
+            chunk = chunk*10 + (*chunkEnd-'0');
+        // value = value*10**digits + chunk
+        const uint64_t mult = power10sTable[chunkEnd-p];
+        uint64_t lo[2], hi[2];
+        mul64Full(value[0], mult, lo);
+        mul64Full(value[1], mult, hi);
+        value[0] = lo[0] + chunk;
+        const uint64_t carry = (value[0] < chunk);
+        value[1] = hi[0] + lo[1];
+        if (hi[1] != 0 || value[1] < lo[1])
+            throw ParseException("Number out of range");
+        value[1] += carry;
+        if (value[1] < carry)
+            throw ParseException("Number out of range");
+        p = chunkEnd;
+    }
+    if (p == str)
+        throw ParseException("A missing number");
+    return p;
+}
+
+void CLRX::cstrtou128CStyle(const char* str, const char* inend, const char*& outend,
+            uint64_t* value)
+{
+    if (inend == str)
+        throw ParseException("No characters to parse");
+    
+    if (*str == '0' && inend != str+1 && (str[1] == 'x' || str[1] == 'X' ||
+            str[1] == 'b' || str[1] == 'B'))
+    {   // hex or binary
+        if (inend == str+2)
+            throw ParseException("Number is too short");
+        outend = cstrtobigPow2Radix(str+2, inend, (str[1] == 'x' || str[1] == 'X') ? 4 : 1,
+                    2, value);
+        if (outend == str+2)
+            throw ParseException("A missing number");
+    }
+    else if (*str == '0') // octal (if no octal parsed, then zero)
+        outend = cstrtobigPow2Radix(str+1, inend, 3, 2, value);
+    else // decimal
+        outend = cstrtou128Decimal(str, inend, value);
+}
+
+void CLRX::cstrtoi128CStyle(const char* str, const char* inend, const char*& outend,
+            uint64_t* value)
+{
+    if (inend == str)
+        throw ParseException("No characters to parse");
+    const bool negative = (*str == '-');
+    if (negative)
+        str++;
+    cstrtou128CStyle(str, inend, outend, value);
+    if (negative)
+    {   // -2**127 is allowed
+        if (value[1] > (1ULL<<63) || (value[1] == (1ULL<<63) && value[0] != 0))
+            throw ParseException("Number out of range");
+        value[0] = -value[0];
+        value[1] = ~value[1] + (value[0] == 0);
+    }
+    else if ((value[1] >> 63) != 0)
+        throw ParseException("Number out of range");
+}
+
+/* put decimal value (decValue*10**decExpOfValue) to string in human readable form
+ * or scientific form. trailing zeroes are skipped */
+static size_t fXtocstrPutDecimal(uint64_t decValue, int decExpOfValue, bool signOfValue,
+            char* str, size_t maxSize, bool scientific)
+{
+    char* p = str;
+    const cxuint digitsNum = u64DecDigitsNum(decValue);
+    
+    cxuint roundPos = 0;
+    // count roundPos (trailing zeroes)
+    for (uint64_t tmpVal = decValue; tmpVal % 10U == 0; roundPos++)
+        tmpVal /= 10U;
+    
+    if (digitsNum-roundPos > maxSize)
+        throw Exception("Max size is too small");
+    
+    const char* strend = str + maxSize-1;
+    
+    if (signOfValue)
+    {
+        if (p >= strend)
+            throw Exception("Max size is too small");
+        *p++ = '-';
+    }
+    
+    cxuint commaPos = digitsNum-1;
+    cxint decExponent = decExpOfValue + digitsNum - 1;
+    if (!scientific)
+    {
+        if (decExponent >= -5 && decExponent < 0)
+        {   // over same number
+            if (p+2 > strend)
+                throw Exception("Max size is too small");
+            *p++ = '0';
+            *p++ = '.';
+            for (cxint dx = -1; dx > decExponent; dx--)
+            {
+                if (p >= strend)
+                    throw Exception("Max size is too small");
+                *p++ = '0';
+            }
+            commaPos = digitsNum;
+        }
+        else if (decExponent >= 0 && decExponent <= int(digitsNum-1))
+        {
+            commaPos = digitsNum - decExponent - 1;
+            roundPos = std::min(commaPos, roundPos);
+        }
+    }
+    /* put to string */
+    if (p + digitsNum-roundPos > strend) // out of string
+        throw Exception("Max size is too small");
+    
+    // write digits directly (without skipped zeroes)
+    const cxuint outDigitsNum = digitsNum-roundPos;
+    u64WriteDecDigits(decValue / power10sTable[roundPos], outDigitsNum, p);
+    if (commaPos > roundPos && commaPos < digitsNum)
+    {   // insert comma after integer part
+        const cxuint intDigitsNum = digitsNum-commaPos;
+        ::memmove(p+intDigitsNum+1, p+intDigitsNum, outDigitsNum-intDigitsNum);
+        p[intDigitsNum] = '.';
+        p++;
+    }
+    p += outDigitsNum;
+    
+    if (p > strend) // out of string
+        throw Exception("Max size is too small");
+        
+    if (scientific || decExponent < -5 || decExponent > int(digitsNum-1))
+    {   /* print exponent */
+        if (p >= strend) // out of string
+            throw Exception("Max size is too small");
+        *p++ = 'e';
+        if (decExponent < 0)
+        {
+            *p++ = '-';
+            decExponent = -decExponent;
+        }
+        else
+            *p++ = '+';
+        
+        const cxuint decExpDigitsNum = (decExponent != 0) ?
+                u64DecDigitsNum(decExponent) : 1;
+        if ((p + decExpDigitsNum) > strend)
+            throw Exception("Max size is too small");
+        
+        u64WriteDecDigits(decExponent, decExpDigitsNum, p);
+        p += decExpDigitsNum;
+    }
+    
+    *p = 0;
+    return p-str;
+}
+
+/*
+ * shortest round-trip conversion (Ryu algorithm by Ulf Adams).
+ * uses only 64x128-bit multiplications with 125-bit powers of 5
+ */
+
+/* multipliers for shortest conversion (125 bits of 5**-q), q=0..341 */
+static const uint64_t pow5InvShortestTable[342][2] =
+{
+    { 0x0000000000000001ULL, 0x2000000000000000ULL },
+    { 0x999999999999999aULL, 0x1999999999999999ULL },
+    { 0x47ae147ae147ae15ULL, 0x147ae147ae147ae1ULL },
+    { 0x6c8b4395810624deULL, 0x10624dd2f1a9fbe7ULL },
+    { 0x7a786c226809d496ULL, 0x1a36e2eb1c432ca5ULL },
+    { 0x61f9f01b866e43abULL, 0x14f8b588e368f084ULL },
+    { 0xb4c7f34938583622ULL, 0x10c6f7a0b5ed8d36ULL },
+    { 0x87a6520ec08d236aULL, 0x1ad7f29abcaf4857ULL },
+    { 0x9fb841a566d74f88ULL, 0x15798ee2308c39dfULL },
+    { 0xe62d01511f12a607ULL, 0x112e0be826d694b2ULL },
+    { 0xd6ae6881cb5109a4ULL, 0x1b7cdfd9d7bdbab7ULL },
+    { 0xdef1ed34a2a73aeaULL, 0x15fd7fe17964955fULL },
+    { 0x7f27f0f6e885c8bbULL, 0x119799812dea1119ULL },
+    { 0x650cb4be40d60df8ULL, 0x1c25c268497681c2ULL },
+    { 0xea70909833de7193ULL, 0x16849b86a12b9b01ULL },
+    { 0x21f3a6e0297ec143ULL, 0x1203af9ee756159bULL },
+    { 0x6985d7cd0f313537ULL, 0x1cd2b297d889bc2bULL },
+    { 0x2137dfd73f5a90f9ULL, 0x170ef54646d49689ULL },
+    { 0xe75fe645cc4873faULL, 0x12725dd1d243aba0ULL },
+    { 0xa5663d3c7a0d865dULL, 0x1d83c94fb6d2ac34ULL },
+    { 0x511e976394d79eb1ULL, 0x179ca10c9242235dULL },
+    { 0xda7edf82dd794bc1ULL, 0x12e3b40a0e9b4f7dULL },
+    { 0x2a6498d1625bac68ULL, 0x1e392010175ee596ULL },
+    { 0xeeb6e0a781e2f053ULL, 0x182db34012b25144ULL },
+    { 0x58924d52ce4f26a9ULL, 0x1357c299a88ea76aULL },
+    { 0x27507bb7b07ea441ULL, 0x1ef2d0f5da7dd8aaULL },
+    { 0x52a6c95fc0655034ULL, 0x18c240c4aecb13bbULL },
+    { 0x0eebd44c99eaa690ULL, 0x13ce9a36f23c0fc9ULL },
+    { 0xb17953adc3110a80ULL, 0x1fb0f6be50601941ULL },
+    { 0xc12ddc8b02740867ULL, 0x195a5efea6b34767ULL },
+    { 0x3424b06f3529a052ULL, 0x14484bfeebc29f86ULL },
+    { 0x901d59f290ee19dbULL, 0x1039d66589687f9eULL },
+    { 0x4cfbc31db4b0295fULL, 0x19f623d5a8a73297ULL },
+    { 0x3d9635b15d59bab2ULL, 0x14c4e977ba1f5bacULL },
+    { 0x97ab5e277de16228ULL, 0x109d8792fb4c4956ULL },
+    { 0xf2abc9d8c9689d0dULL, 0x1a95a5b7f87a0ef0ULL },
+    { 0x5bbca17a3aba173eULL, 0x154484932d2e725aULL },
+    { 0xafca1ac82efb45cbULL, 0x11039d428a8b8eaeULL },
+    { 0xb2dcf7a6b1920945ULL, 0x1b38fb9daa78e44aULL },
+    { 0xf57d92ebc141a104ULL, 0x15c72fb1552d836eULL },
+    { 0xc46475896767b403ULL, 0x116c262777579c58ULL },
+    { 0x6d6d88dbd8a5ecd2ULL, 0x1be03d0bf225c6f4ULL },
+    { 0x8abe071646eb23dbULL, 0x164cfda3281e38c3ULL },
+    { 0x6efe6c11d255b649ULL, 0x11d7314f534b609cULL },
+    { 0xb197134fb6ef8a0eULL, 0x1c8b821885456760ULL },
+    { 0x27ac0f72f8bfa1a5ULL, 0x16d601ad376ab91aULL },
+    { 0xb95672c260994e1eULL, 0x1244ce242c5560e1ULL },
+    { 0xf5571e03cdc21695ULL, 0x1d3ae36d13bbce35ULL },
+    { 0x2aac18030b01ababULL, 0x17624f8a762fd82bULL },
+    { 0xbbbce0026f348956ULL, 0x12b50c6ec4f31355ULL },
+    { 0x92c7ccd0b1eda889ULL, 0x1dee7a4ad4b81eefULL },
+    { 0xdbd30a408e57ba07ULL, 0x17f1fb6f10934bf2ULL },
+    { 0x7ca8d50071dfc806ULL, 0x1327fc58da0f6ff5ULL },
+    { 0xfaa7bb33e9660cd6ULL, 0x1ea6608e29b24cbbULL },
+    { 0x9552fc298784d711ULL, 0x18851a0b548ea3c9ULL },
+    { 0xaaa8c9bad2d0ac0eULL, 0x139dae6f76d88307ULL },
+    { 0xdddadc5e1e1aace3ULL, 0x1f62b0b257c0d1a5ULL },
+    { 0x7e48b04b4b488a4fULL, 0x191bc08eac9a4151ULL },
+    { 0xcb6d59d5d5d3a1d9ULL, 0x141633a556e1cddaULL },
+    { 0x3c577b1177dc817bULL, 0x1011c2eaabe7d7e2ULL },
+    { 0xc6f25e825960cf2aULL, 0x19b604aaaca62636ULL },
+    { 0x6bf518684780a5bbULL, 0x14919d5556eb51c5ULL },
+    { 0x232a79ed06008496ULL, 0x10747ddddf22a7d1ULL },
+    { 0xd1dd8fe1a3340756ULL, 0x1a53fc9631d10c81ULL },
+    { 0xa7e4731ae8f66c45ULL, 0x150ffd44f4a73d34ULL },
+    { 0x531d28e253f8569eULL, 0x10d9976a5d52975dULL },
+    { 0xeb61db03b98d5762ULL, 0x1af5bf109550f22eULL },
+    { 0xbc4e48cfc7a445e8ULL, 0x159165a6ddda5b58ULL },
+    { 0x6371d3d96c836b20ULL, 0x11411e1f17e1e2adULL },
+    { 0x9f1c8628ad9f11cdULL, 0x1b9b6364f3030448ULL },
+    { 0xe5b06b53be18db0bULL, 0x1615e91d8f359d06ULL },
+    { 0xeaf3890fcb4715a2ULL, 0x11ab20e472914a6bULL },
+    { 0x44b8db4c7871bc37ULL, 0x1c45016d841baa46ULL },
+    { 0x03c715d6c6c1635fULL, 0x169d9abe03495505ULL },
+    { 0x3638de456bcde919ULL, 0x1217aefe69077737ULL },
+    { 0x56c163a2461641c1ULL, 0x1cf2b1970e725858ULL },
+    { 0xdf011c81d1ab67ceULL, 0x17288e1271f51379ULL },
+    { 0x7f3416ce4155eca5ULL, 0x1286d80ec190dc61ULL },
+    { 0x6520247d3556476eULL, 0x1da48ce468e7c702ULL },
+    { 0xea801d30f7783925ULL, 0x17b6d71d20b96c01ULL },
+    { 0xbb99b0f3f92cfa84ULL, 0x12f8ac174d612334ULL },
+    { 0x5f5c4e532847f739ULL, 0x1e5aacf215683854ULL },
+    { 0x7f7d0b75b9d32c2eULL, 0x18488a5b44536043ULL },
+    { 0x9930d5f7c7dc2358ULL, 0x136d3b7c36a919cfULL },
+    { 0x8eb4898c72f9d226ULL, 0x1f152bf9f10e8fb2ULL },
+    { 0x722a07a38f2e41b8ULL, 0x18ddbcc7f40ba628ULL },
+    { 0xc1bb394fa5be9afaULL, 0x13e497065cd61e86ULL },
+    { 0x9c5ec2190930f7f6ULL, 0x1fd424d6faf030d7ULL },
+    { 0x49e56814075a5ff8ULL, 0x197683df2f268d79ULL },
+    { 0x6e51201005e1e660ULL, 0x145ecfe5bf520ac7ULL },
+    { 0xf1da800cd181851aULL, 0x104bd984990e6f05ULL },
+    { 0x4fc400148268d4f5ULL, 0x1a12f5a0f4e3e4d6ULL },
+    { 0xd96999aa01ed772bULL, 0x14dbf7b3f71cb711ULL },
+    { 0xadee1488018ac5bcULL, 0x10aff95cc5b09274ULL },
+    { 0x497ceda668de092cULL, 0x1ab328946f80ea54ULL },
+    { 0x3aca57b853e4d424ULL, 0x155c2076bf9a5510ULL },
+    { 0x623b7960431d7683ULL, 0x1116805effaeaa73ULL },
+    { 0x9d2bf566d1c8bd9eULL, 0x1b5733cb32b110b8ULL },
+    { 0x7dbcc452416d647fULL, 0x15df5ca28ef40d60ULL },
+    { 0xcafd69db678ab6ccULL, 0x117f7d4ed8c33de6ULL },
+    { 0xab2f0fc572778adfULL, 0x1bff2ee48e052fd7ULL },
+    { 0x88f273045b92d580ULL, 0x1665bf1d3e6a8cacULL },
+    { 0xd3f528d049424466ULL, 0x11eaff4a98553d56ULL },
+    { 0xb988414d4203a0a3ULL, 0x1cab3210f3bb9557ULL },
+    { 0x6139cdd76802e6e9ULL, 0x16ef5b40c2fc7779ULL },
+    { 0xe761717920025254ULL, 0x125915cd68c9f92dULL },
+    { 0xa568b58e999d5086ULL, 0x1d5b561574765b7cULL },
+    { 0x5120913ee14aa6d2ULL, 0x177c44ddf6c515fdULL },
+    { 0xa74d40ff1aa21f0eULL, 0x12c9d0b1923744caULL },
+    { 0x0baece64f769cb4aULL, 0x1e0fb44f50586e11ULL },
+    { 0x3c8bd850c5ee3c3bULL, 0x180c903f7379f1a7ULL },
+    { 0xca0979da37f1c9c9ULL, 0x133d4032c2c7f485ULL },
+    { 0xa9a8c2f6bfe942dbULL, 0x1ec866b79e0cba6fULL },
+    { 0x2153cf2bccba9be3ULL, 0x18a0522c7e709526ULL },
+    { 0x1aa9728970954982ULL, 0x13b374f06526ddb8ULL },
+    { 0xf775840f1a88759dULL, 0x1f8587e7083e2f8cULL },
+    { 0x5f9136727ba05e17ULL, 0x19379fec0698260aULL },
+    { 0x1940f85b9619e4dfULL, 0x142c7ff0054684d5ULL },
+    { 0xe100c6afab47ea4cULL, 0x1023998cd1053710ULL },
+    { 0xce67a44c453fdd47ULL, 0x19d28f47b4d524e7ULL },
+    { 0xd852e9d69dccb106ULL, 0x14a8729fc3ddb71fULL },
+    { 0x79dbee454b0a2738ULL, 0x1086c219697e2c19ULL },
+    { 0x295fe3a211a9d859ULL, 0x1a71368f0f30468fULL },
+    { 0xbab31c81a7bb137aULL, 0x15275ed8d8f36ba5ULL },
+    { 0x6228e39aec95a92fULL, 0x10ec4be0ad8f8951ULL },
+    { 0x9d0e38f7e0ef7517ULL, 0x1b13ac9aaf4c0ee8ULL },
+    { 0xb0d82d931a592a79ULL, 0x15a956e225d67253ULL },
+    { 0x8d79be0f4847552eULL, 0x11544581b7dec1dcULL },
+    { 0x158f967eda0bbb7cULL, 0x1bba08cf8c979c94ULL },
+    { 0x77a611ff14d62f97ULL, 0x162e6d72d6dfb076ULL },
+    { 0xf951a7ff43de8c79ULL, 0x11bebdf578b2f391ULL },
+    { 0xc21c3ffed2fdad8eULL, 0x1c6463225ab7ec1cULL },
+    { 0x01b0333242648ad8ULL, 0x16b6b5b5155ff017ULL },
+    { 0x0159c28e9b83a246ULL, 0x122bc490dde659acULL },
+    { 0xcef604175f3903a3ULL, 0x1d12d41afca3c2acULL },
+    { 0x725e69ac4c2d9c83ULL, 0x17424348ca1c9bbdULL },
+    { 0xf5185489d68ae39cULL, 0x129b69070816e2fdULL },
+    { 0xee8d540fbdab05c6ULL, 0x1dc574d80cf16b2fULL },
+    { 0xbed77672fe226b05ULL, 0x17d12a4670c1228cULL },
+    { 0xff12c528cb4ebc04ULL, 0x130dbb6b8d674ed6ULL },
+    { 0xcb513b74787df9a0ULL, 0x1e7c5f127bd87e24ULL },
+    { 0x090dc929f9fe614dULL, 0x18637f41fcad31b7ULL },
+    { 0xa0d7d42194cb810aULL, 0x1382cc34ca2427c5ULL },
+    { 0x67bfb9cf5478ce77ULL, 0x1f37ad21436d0c6fULL },
+    { 0x1fcc94a5dd2d71f9ULL, 0x18f9574dcf8a7059ULL },
+    { 0x7fd6dd517dbdf4c7ULL, 0x13faac3e3fa1f37aULL },
+    { 0xffbe2ee8c92fee0bULL, 0x1ff779fd329cb8c3ULL },
+    { 0x6631bf20a0f324d6ULL, 0x1992c7fdc216fa36ULL },
+    { 0xb827cc1a1a5c1d78ULL, 0x14756ccb01abfb5eULL },
+    { 0x935309ae7b7ce460ULL, 0x105df0a267bcc918ULL },
+    { 0x1eeb42b0c594a099ULL, 0x1a2fe76a3f9474f4ULL },
+    { 0xe58902270476e6e1ULL, 0x14f31f8832dd2a5cULL },
+    { 0xb7a0ce859d2bebe7ULL, 0x10c27fa028b0eeb0ULL },
+    { 0x59014a6f61dfdfd8ULL, 0x1ad0cc33744e4ab4ULL },
+    { 0xe0cdd525e7e64cadULL, 0x1573d68f903ea229ULL },
+    { 0x4d7177518651d6f1ULL, 0x11297872d9cbb4eeULL },
+    { 0x7be8bee8d6e957e8ULL, 0x1b758d848fac54b0ULL },
+    { 0xfcba3253df211320ULL, 0x15f7a46a0c89dd59ULL },
+    { 0x63c8284318e74280ULL, 0x1192e9ee706e4aaeULL },
+    { 0x060d0d3827d86a66ULL, 0x1c1e43171a4a1117ULL },
+    { 0x6b3da42cecad21ebULL, 0x167e9c127b6e7412ULL },
+    { 0x88fe1cf0bd574e56ULL, 0x11fee341fc585cdbULL },
+    { 0x419694b462254a23ULL, 0x1ccb0536608d615fULL },
+    { 0x67abaa29e81dd4e9ULL, 0x1708d0f84d3de77fULL },
+    { 0xb95621bb2017dd87ULL, 0x126d73f9d764b932ULL },
+    { 0xc223692b668c95a5ULL, 0x1d7becc2f23ac1eaULL },
+    { 0xce82ba891ed6de1dULL, 0x179657025b6234bbULL },
+    { 0xa53562074bdf1818ULL, 0x12deac01e2b4f6fcULL },
+    { 0x3b889cd87964f359ULL, 0x1e3113363787f194ULL },
+    { 0xfc6d4a46c783f5e1ULL, 0x18274291c6065adcULL },
+    { 0x30576e9f06032b1aULL, 0x13529ba7d19eaf17ULL },
+    { 0x1a257dcb3cd1de90ULL, 0x1eea92a61c311825ULL },
+    { 0x481dfe3c30a7e540ULL, 0x18bba884e35a79b7ULL },
+    { 0xd34b31c9c0865100ULL, 0x13c9539d82aec7c5ULL },
+    { 0x5211e942cda3b4cdULL, 0x1fa885c8d117a609ULL },
+    { 0x74db21023e1c90a4ULL, 0x19539e3a40dfb807ULL },
+    { 0xf715b401cb4a0d50ULL, 0x1442e4fb67196005ULL },
+    { 0xf8de299b09080aa7ULL, 0x103583fc527ab337ULL },
+    { 0x8e304291a80cddd7ULL, 0x19ef3993b72ab859ULL },
+    { 0x3e8d020e200a4b13ULL, 0x14bf6142f8eef9e1ULL },
+    { 0x653d9b3e80083c0fULL, 0x10991a9bfa58c7e7ULL },
+    { 0x6ec8f864000d2ce4ULL, 0x1a8e90f9908e0ca5ULL },
+    { 0x8bd3f9e999a423eaULL, 0x153eda614071a3b7ULL },
+    { 0x3ca994bae1501cbbULL, 0x10ff151a99f482f9ULL },
+    { 0xc775bac49bb3612bULL, 0x1b31bb5dc320d18eULL },
+    { 0xd2c4956a16291a89ULL, 0x15c162b168e70e0bULL },
+    { 0xdbd0778811ba7ba1ULL, 0x11678227871f3e6fULL },
+    { 0x2c80bf401c5d929bULL, 0x1bd8d03f3e9863e6ULL },
+    { 0xbd33cc3349e47549ULL, 0x16470cff6546b651ULL },
+    { 0xca8fd68f6e505dd4ULL, 0x11d270cc51055ea7ULL },
+    { 0x4419574be3b3c953ULL, 0x1c83e7ad4e6efdd9ULL },
+    { 0x0347790982f63aa9ULL, 0x16cfec8aa52597e1ULL },
+    { 0xcf6c60d468c4fbbaULL, 0x123ff06eea847980ULL },
+    { 0xe57a34870e07f92aULL, 0x1d331a4b10d3f59aULL },
+    { 0x512e906c0b399422ULL, 0x175c1508da432ae2ULL },
+    { 0xda8ba6bcd5c7a9b5ULL, 0x12b010d3e1cf5581ULL },
+    { 0x90df712e22d90f87ULL, 0x1de6815302e5559cULL },
+    { 0xda4c5a8b4f140c6cULL, 0x17eb9aa8cf1dde16ULL },
+    { 0xaea37ba2a5a9a38aULL, 0x1322e220a5b17e78ULL },
+    { 0x7dd25f6aa2a905a9ULL, 0x1e9e369aa2b59727ULL },
+    { 0x97db7f888220d154ULL, 0x187e92154ef7ac1fULL },
+    { 0x797c6606ce80a777ULL, 0x139874ddd8c6234cULL },
+    { 0x8f2d700ae4010bf1ULL, 0x1f5a549627a36badULL },
+    { 0x0c2459a25000d65aULL, 0x191510781fb5efbeULL },
+    { 0x701d1481d99a4515ULL, 0x1410d9f9b2f7f2feULL },
+    { 0xc017439b147b6a77ULL, 0x100d7b2e28c65bfeULL },
+    { 0xccf205c4ed9243f2ULL, 0x19af2b7d0e0a2ccaULL },
+    { 0x0a5b37d0be0e9cc2ULL, 0x148c22ca71a1bd6fULL },
+    { 0x0848f973cb3ee3ceULL, 0x10701bd527b4978cULL },
+    { 0xda0e5bec78649fb0ULL, 0x1a4cf9550c5425acULL },
+    { 0x7b3eaff060507fc0ULL, 0x150a6110d6a9b7bdULL },
+    { 0x95cbbff380406633ULL, 0x10d51a73deee2c97ULL },
+    { 0xefac665266cd7052ULL, 0x1aee90b964b04758ULL },
+    { 0x2623850eb8a459dbULL, 0x158ba6fab6f36c47ULL },
+    { 0x1e82d0d893b6ae49ULL, 0x113c85955f29236cULL },
+    { 0xfd9e1af41f8ab075ULL, 0x1b9408eefea838acULL },
+    { 0x97b1af29b2d559f7ULL, 0x16100725988693bdULL },
+    { 0xac8e25baf5777b2cULL, 0x11a66c1e139edc97ULL },
+    { 0x7a7d092b2258c513ULL, 0x1c3d79c9b8fe2dbfULL },
+    { 0x61fda0ef4ead6a76ULL, 0x169794a160cb57ccULL },
+    { 0xe7fe1a590bbdeec5ULL, 0x1212dd4de7091309ULL },
+    { 0xa6635d5b45fcb13aULL, 0x1ceafbafd80e84dcULL },
+    { 0x851c4aaf6b308dc8ULL, 0x172262f3133ed0b0ULL },
+    { 0xd0e36ef2bc26d7d4ULL, 0x1281e8c275cbda26ULL },
+    { 0xb49f17eac6a48c86ULL, 0x1d9ca79d894629d7ULL },
+    { 0x2a18dfef0550706bULL, 0x17b08617a104ee46ULL },
+    { 0x54e0b3259dd9f389ULL, 0x12f39e794d9d8b6bULL },
+    { 0x87cdeb6f62f65274ULL, 0x1e5297287c2f4578ULL },
+    { 0xd30b22bf825ea85dULL, 0x18421286c9bf6ac6ULL },
+    { 0x0f3c1bcc684bb9e4ULL, 0x13680ed23aff889fULL },
+    { 0x18602c7a4079296dULL, 0x1f0ce4839198da98ULL },
+    { 0x46b356c833942124ULL, 0x18d71d360e13e213ULL },
+    { 0x388f78a029434db6ULL, 0x13df4a91a4dcb4dcULL },
+    { 0x5a7f2766a86baf8aULL, 0x1fcbaa82a1612160ULL },
+    { 0x153285ebb9efbfa2ULL, 0x196fbb9bb44db44dULL },
+    { 0xaa8ed189618c994eULL, 0x145962e2f6a4903dULL },
+    { 0xeed8a7a11ad6e10cULL, 0x1047824f2bb6d9caULL },
+    { 0x7e27729b5e249b45ULL, 0x1a0c03b1df8af611ULL },
+    { 0xfe85f549181d4904ULL, 0x14d6695b193bf80dULL },
+    { 0xcb9e5dd4134aa0d0ULL, 0x10ab877c142ff9a4ULL },
+    { 0xdf63c9535211014dULL, 0x1aac0bf9b9e65c3aULL },
+    { 0x191ca10f74da6771ULL, 0x15566ffafb1eb02fULL },
+    { 0xadb080d92a4852c1ULL, 0x1111f32f2f4bc025ULL },
+    { 0x15e7348eaa0d5134ULL, 0x1b4feb7eb212cd09ULL },
+    { 0xab1f5d3eee710dc4ULL, 0x15d98932280f0a6dULL },
+    { 0xbc1917658b8da49dULL, 0x117ad428200c0857ULL },
+    { 0x2cf4f23c127c3a94ULL, 0x1bf7b9d9cce00d59ULL },
+    { 0xf0c3f4fcdb969543ULL, 0x165fc7e170b33de0ULL },
+    { 0x5a365d9716121103ULL, 0x11e6398126f5cb1aULL },
+    { 0x9056fc24f01ce804ULL, 0x1ca38f350b22de90ULL },
+    { 0xd9df301d8ce3ecd0ULL, 0x16e93f5da2824ba6ULL },
+    { 0xe17f59b13d8323daULL, 0x125432b14ecea2ebULL },
+    { 0x68cbc2b52f38395cULL, 0x1d53844ee47dd179ULL },
+    { 0x53d6355dbf602de3ULL, 0x177603725064a794ULL },
+    { 0xa9782ab165e68b1cULL, 0x12c4cf8ea6b6ec76ULL },
+    { 0x0f26aab56fd744faULL, 0x1e07b27dd78b13f1ULL },
+    { 0x3f52222abfdf6a62ULL, 0x18062864ac6f4327ULL },
+    { 0x65db4e88997f884eULL, 0x1338205089f29c1fULL },
+    { 0x6fc54a7428cc0d4aULL, 0x1ec033b40fea9365ULL },
+    { 0x596aa1f68709a43bULL, 0x1899c2f673220f84ULL },
+    { 0xadeee7f86c07b696ULL, 0x13ae3591f5b4d936ULL },
+    { 0x497e3ff3e00c5756ULL, 0x1f7d228322baf524ULL },
+    { 0xd464fff64cd6ac45ULL, 0x1930e868e89590e9ULL },
+    { 0x4383fff83d7889d1ULL, 0x14272053ed4473eeULL },
+    { 0xcf9cccc69793a174ULL, 0x101f4d0ff1038ff1ULL },
+    { 0x7f6147a425b90252ULL, 0x19cbae7fe805b31cULL },
+    { 0xcc4dd2e9b7c7350fULL, 0x14a2f1ffecd15c16ULL },
+    { 0x3d0b0f215fd290d9ULL, 0x10825b3323dab012ULL },
+    { 0x61ab4b689950e7c1ULL, 0x1a6a2b85062ab350ULL },
+    { 0x4e22a2ba1440b967ULL, 0x1521bc6a6b555c40ULL },
+    { 0x0b4ee894dd009453ULL, 0x10e7c9eebc4449cdULL },
+    { 0x1217da87c800ed51ULL, 0x1b0c764ac6d3a948ULL },
+    { 0xdb46486ca000bddaULL, 0x15a391d56bdc876cULL },
+    { 0x490506bd4ccd64afULL, 0x114fa7ddefe39f8aULL },
+    { 0xa8080ac87ae23ab1ULL, 0x1bb2a62fe638ff43ULL },
+    { 0x5339a239fbe82ef4ULL, 0x162884f31e93ff69ULL },
+    { 0x75c7b4fb2fecf25dULL, 0x11ba03f5b20fff87ULL },
+    { 0x22d92191e647ea2eULL, 0x1c5cd322b67fff3fULL },
+    { 0xb57a8141850654f2ULL, 0x16b0a8e891ffff65ULL },
+    { 0xc4620101373843f5ULL, 0x1226ed86db3332b7ULL },
+    { 0x3a366801f1f39feeULL, 0x1d0b15a491eb8459ULL },
+    { 0xfb5eb99b27f6198bULL, 0x173c115074bc69e0ULL },
+    { 0x2f7efae2865e7ad6ULL, 0x129674405d6387e7ULL },
+    { 0xe597f7d0d6fd9156ULL, 0x1dbd86cd6238d971ULL },
+    { 0x8479930d78cadaabULL, 0x17cad23de82d7ac1ULL },
+    { 0xd06142712d6f1556ULL, 0x1308a831868ac89aULL },
+    { 0x4d686a4eaf182222ULL, 0x1e74404f3daada91ULL },
+    { 0xa453883ef279b4e8ULL, 0x185d003f6488aedaULL },
+    { 0xe9dc6cff28615d87ULL, 0x137d99cc506d58aeULL },
+    { 0xa960ae650d6895a4ULL, 0x1f2f5c7a1a488de4ULL },
+    { 0xbab3beb73ded4483ULL, 0x18f2b061aea07183ULL },
+    { 0x2ef6322c318a9d36ULL, 0x13f559e7bee6c136ULL },
+    { 0xe4bd1d13827761f0ULL, 0x1feef63f97d79b89ULL },
+    { 0x83ca7da9352c4e5aULL, 0x198bf832dfdfafa1ULL },
+    { 0x9ca1fe20f756a515ULL, 0x146ff9c24cb2f2e7ULL },
+    { 0x4a1b31b3f9121daaULL, 0x1059949b708f28b9ULL },
+    { 0x435eb5ecc1b695ddULL, 0x1a28edc580e50df5ULL },
+    { 0x35e55e57015ede4aULL, 0x14ed8b04671da4c4ULL },
+    { 0xc4b77eac0118b1d5ULL, 0x10be08d0527e1d69ULL },
+    { 0xa12597799b5ab622ULL, 0x1ac9a7b3b7302f0fULL },
+    { 0x4db7ac6149155e81ULL, 0x156e1fc2f8f358d9ULL },
+    { 0xd7c6238107444b9bULL, 0x1124e63593f5e0adULL },
+    { 0x593d059b3ed3ac2bULL, 0x1b6e3d2286563449ULL },
+    { 0xe0fd9e15cbdc89bcULL, 0x15f1ca820511c36dULL },
+    { 0xb3fe18116fe3a163ULL, 0x118e3b9b37416924ULL },
+    { 0x866359b57fd29bd1ULL, 0x1c16c5c525357507ULL },
+    { 0xd1e91491330ee30eULL, 0x16789e3750f790d2ULL },
+    { 0x74ba76da8f3f1c0bULL, 0x11fa182c40c60d75ULL },
+    { 0xedf72490e531c678ULL, 0x1cc359e067a348bbULL },
+    { 0x8b2c1d40b75b052dULL, 0x1702ae4d1fb5d3c9ULL },
+    { 0x6f567dcd5f7c0424ULL, 0x12688b70e62b0fd4ULL },
+    { 0x7ef0c94898c66d06ULL, 0x1d74124e3d11b2edULL },
+    { 0x98c0a106e09ebd9fULL, 0x17900ea4fda7c257ULL },
+    { 0x470080d24d4bcae6ULL, 0x12d9a550caec9b79ULL },
+    { 0xd800ce1d487944a2ULL, 0x1e29088144adc58eULL },
+    { 0x1333d8176d2dd082ULL, 0x1820d39a9d57d13fULL },
+    { 0xa8f646792424a6ceULL, 0x134d76154aaca765ULL },
+    { 0x74bd3d8ea03aa47dULL, 0x1ee25688777aa56fULL },
+    { 0x5d64313ee6955064ULL, 0x18b51206c5fbb78cULL },
+    { 0x4ab68dcbebaaa6b7ULL, 0x13c40e6bd1962c70ULL },
+    { 0x1124161312aaa457ULL, 0x1fa01712e8f0471aULL },
+    { 0xda8344dc0eeee9dfULL, 0x194cdf4253f36c14ULL },
+    { 0xe2029d7cd8bf2180ULL, 0x143d7f6843292343ULL },
+    { 0x4e687dfd7a328133ULL, 0x103132b9cf541c36ULL },
+    { 0x4a40c9959050ceb8ULL, 0x19e851294bb9c6bdULL },
+    { 0x0833d477a6a70bc6ULL, 0x14b9da876fc7d231ULL },
+    { 0xa02976c61eec096bULL, 0x1094aed2bfd30e8dULL },
+    { 0x004257a364acdbdfULL, 0x1a877e1dffb81749ULL },
+    { 0xcd01dfb5ea23e319ULL, 0x153931b1996012a0ULL },
+    { 0x70ce4c91881cb5aeULL, 0x10fa8e27ade6754dULL },
+    { 0x1ae3adb5a69455e2ULL, 0x1b2a7d0c4970bbafULL },
+    { 0x7be957c4854377e8ULL, 0x15bb973d078d62f2ULL },
+    { 0xc987796a0435f987ULL, 0x1162df64060ab58eULL },
+    { 0x75a58f1006bcc271ULL, 0x1bd1656cd67788e4ULL },
+    { 0xf7b7a5a66bca3527ULL, 0x16411df0ab92d3e9ULL },
+    { 0x5fc61e1ebca1c41fULL, 0x11cdb18d560f0feeULL },
+    { 0xffa363646102d365ULL, 0x1c7c4f4889b1b316ULL },
+    { 0x32e91c504d9bdc51ULL, 0x16c9d906d48e28dfULL },
+    { 0x8f20e37371497d0eULL, 0x123b140576d820b2ULL },
+    { 0x7e9b0585820f2e7cULL, 0x1d2b533bf159cdeaULL },
+    { 0xcbaf379e01a5becaULL, 0x1755dc2ff447d7eeULL },
+    { 0x0958f94b348498a1ULL, 0x12ab168cc36cacbfULL }
+};
+
+/* multipliers for shortest conversion (125 bits of 5**i), i=0..325 */
+static const uint64_t pow5ShortestTable[326][2] =
+{
+    { 0x0000000000000000ULL, 0x1000000000000000ULL },
+    { 0x0000000000000000ULL, 0x1400000000000000ULL },
+    { 0x0000000000000000ULL, 0x1900000000000000ULL },
+    { 0x0000000000000000ULL, 0x1f40000000000000ULL },
+    { 0x0000000000000000ULL, 0x1388000000000000ULL },
+    { 0x0000000000000000ULL, 0x186a000000000000ULL },
+    { 0x0000000000000000ULL, 0x1e84800000000000ULL },
+    { 0x0000000000000000ULL, 0x1312d00000000000ULL },
+    { 0x0000000000000000ULL, 0x17d7840000000000ULL },
+    { 0x0000000000000000ULL, 0x1dcd650000000000ULL },
+    { 0x0000000000000000ULL, 0x12a05f2000000000ULL },
+    { 0x0000000000000000ULL, 0x174876e800000000ULL },
+    { 0x0000000000000000ULL, 0x1d1a94a200000000ULL },
+    { 0x0000000000000000ULL, 0x12309ce540000000ULL },
+    { 0x0000000000000000ULL, 0x16bcc41e90000000ULL },
+    { 0x0000000000000000ULL, 0x1c6bf52634000000ULL },
+    { 0x0000000000000000ULL, 0x11c37937e0800000ULL },
+    { 0x0000000000000000ULL, 0x16345785d8a00000ULL },
+    { 0x0000000000000000ULL, 0x1bc16d674ec80000ULL },
+    { 0x0000000000000000ULL, 0x1158e460913d0000ULL },
+    { 0x0000000000000000ULL, 0x15af1d78b58c4000ULL },
+    { 0x0000000000000000ULL, 0x1b1ae4d6e2ef5000ULL },
+    { 0x0000000000000000ULL, 0x10f0cf064dd59200ULL },
+    { 0x0000000000000000ULL, 0x152d02c7e14af680ULL },
+    { 0x0000000000000000ULL, 0x1a784379d99db420ULL },
+    { 0x0000000000000000ULL, 0x108b2a2c28029094ULL },
+    { 0x0000000000000000ULL, 0x14adf4b7320334b9ULL },
+    { 0x4000000000000000ULL, 0x19d971e4fe8401e7ULL },
+    { 0x8800000000000000ULL, 0x1027e72f1f128130ULL },
+    { 0xaa00000000000000ULL, 0x1431e0fae6d7217cULL },
+    { 0xd480000000000000ULL, 0x193e5939a08ce9dbULL },
+    { 0xc9a0000000000000ULL, 0x1f8def8808b02452ULL },
+    { 0xbe04000000000000ULL, 0x13b8b5b5056e16b3ULL },
+    { 0xad85000000000000ULL, 0x18a6e32246c99c60ULL },
+    { 0xd8e6400000000000ULL, 0x1ed09bead87c0378ULL },
+    { 0x878fe80000000000ULL, 0x13426172c74d822bULL },
+    { 0x6973e20000000000ULL, 0x1812f9cf7920e2b6ULL },
+    { 0x03d0da8000000000ULL, 0x1e17b84357691b64ULL },
+    { 0x8262889000000000ULL, 0x12ced32a16a1b11eULL },
+    { 0x22fb2ab400000000ULL, 0x178287f49c4a1d66ULL },
+    { 0xabb9f56100000000ULL, 0x1d6329f1c35ca4bfULL },
+    { 0xcb54395ca0000000ULL, 0x125dfa371a19e6f7ULL },
+    { 0xbe2947b3c8000000ULL, 0x16f578c4e0a060b5ULL },
+    { 0x2db399a0ba000000ULL, 0x1cb2d6f618c878e3ULL },
+    { 0xfc90400474400000ULL, 0x11efc659cf7d4b8dULL },
+    { 0x7bb4500591500000ULL, 0x166bb7f0435c9e71ULL },
+    { 0xdaa16406f5a40000ULL, 0x1c06a5ec5433c60dULL },
+    { 0xa8a4de8459868000ULL, 0x118427b3b4a05bc8ULL },
+    { 0xd2ce16256fe82000ULL, 0x15e531a0a1c872baULL },
+    { 0x87819baecbe22800ULL, 0x1b5e7e08ca3a8f69ULL },
+    { 0xf4b1014d3f6d5900ULL, 0x111b0ec57e6499a1ULL },
+    { 0x71dd41a08f48af40ULL, 0x1561d276ddfdc00aULL },
+    { 0x0e549208b31adb10ULL, 0x1aba4714957d300dULL },
+    { 0x28f4db456ff0c8eaULL, 0x10b46c6cdd6e3e08ULL },
+    { 0x33321216cbecfb24ULL, 0x14e1878814c9cd8aULL },
+    { 0xbffe969c7ee839edULL, 0x1a19e96a19fc40ecULL },
+    { 0xf7ff1e21cf512434ULL, 0x105031e2503da893ULL },
+    { 0xf5fee5aa43256d41ULL, 0x14643e5ae44d12b8ULL },
+    { 0x337e9f14d3eec892ULL, 0x197d4df19d605767ULL },
+    { 0x005e46da08ea7ab6ULL, 0x1fdca16e04b86d41ULL },
+    { 0xa03aec4845928cb2ULL, 0x13e9e4e4c2f34448ULL },
+    { 0xc849a75a56f72fdeULL, 0x18e45e1df3b0155aULL },
+    { 0x7a5c1130ecb4fbd6ULL, 0x1f1d75a5709c1ab1ULL },
+    { 0xec798abe93f11d65ULL, 0x13726987666190aeULL },
+    { 0xa797ed6e38ed64bfULL, 0x184f03e93ff9f4daULL },
+    { 0x517de8c9c728bdefULL, 0x1e62c4e38ff87211ULL },
+    { 0xd2eeb17e1c7976b5ULL, 0x12fdbb0e39fb474aULL },
+    { 0x87aa5ddda397d462ULL, 0x17bd29d1c87a191dULL },
+    { 0xe994f5550c7dc97bULL, 0x1dac74463a989f64ULL },
+    { 0x11fd195527ce9dedULL, 0x128bc8abe49f639fULL },
+    { 0xd67c5faa71c24568ULL, 0x172ebad6ddc73c86ULL },
+    { 0x8c1b77950e32d6c2ULL, 0x1cfa698c95390ba8ULL },
+    { 0x57912abd28dfc639ULL, 0x121c81f7dd43a749ULL },
+    { 0xad75756c7317b7c8ULL, 0x16a3a275d494911bULL },
+    { 0x98d2d2c78fdda5baULL, 0x1c4c8b1349b9b562ULL },
+    { 0x9f83c3bcb9ea8794ULL, 0x11afd6ec0e14115dULL },
+    { 0x0764b4abe8652979ULL, 0x161bcca7119915b5ULL },
+    { 0x493de1d6e27e73d7ULL, 0x1ba2bfd0d5ff5b22ULL },
+    { 0x6dc6ad264d8f0866ULL, 0x1145b7e285bf98f5ULL },
+    { 0xc938586fe0f2ca80ULL, 0x159725db272f7f32ULL },
+    { 0x7b866e8bd92f7d20ULL, 0x1afcef51f0fb5effULL },
+    { 0xad34051767bdae34ULL, 0x10de1593369d1b5fULL },
+    { 0x9881065d41ad19c1ULL, 0x15159af804446237ULL },
+    { 0x7ea147f492186032ULL, 0x1a5b01b605557ac5ULL },
+    { 0x6f24ccf8db4f3c1fULL, 0x1078e111c3556cbbULL },
+    { 0x4aee003712230b27ULL, 0x14971956342ac7eaULL },
+    { 0xdda98044d6abcdf0ULL, 0x19bcdfabc13579e4ULL },
+    { 0x0a89f02b062b60b6ULL, 0x10160bcb58c16c2fULL },
+    { 0xcd2c6c35c7b638e4ULL, 0x141b8ebe2ef1c73aULL },
+    { 0x8077874339a3c71dULL, 0x1922726dbaae3909ULL },
+    { 0xe0956914080cb8e4ULL, 0x1f6b0f092959c74bULL },
+    { 0x6c5d61ac8507f38eULL, 0x13a2e965b9d81c8fULL },
+    { 0x4774ba17a649f072ULL, 0x188ba3bf284e23b3ULL },
+    { 0x1951e89d8fdc6c8fULL, 0x1eae8caef261aca0ULL },
+    { 0x0fd3316279e9c3d9ULL, 0x132d17ed577d0be4ULL },
+    { 0x13c7fdbb186434cfULL, 0x17f85de8ad5c4eddULL },
+    { 0x58b9fd29de7d4203ULL, 0x1df67562d8b36294ULL },
+    { 0xb7743e3a2b0e4942ULL, 0x12ba095dc7701d9cULL },
+    { 0xe5514dc8b5d1db92ULL, 0x17688bb5394c2503ULL },
+    { 0xdea5a13ae3465277ULL, 0x1d42aea2879f2e44ULL },
+    { 0x0b2784c4ce0bf38aULL, 0x1249ad2594c37cebULL },
+    { 0xcdf165f6018ef06dULL, 0x16dc186ef9f45c25ULL },
+    { 0x416dbf7381f2ac88ULL, 0x1c931e8ab871732fULL },
+    { 0x88e497a83137abd5ULL, 0x11dbf316b346e7fdULL },
+    { 0xeb1dbd923d8596caULL, 0x1652efdc6018a1fcULL },
+    { 0x25e52cf6cce6fc7dULL, 0x1be7abd3781eca7cULL },
+    { 0x97af3c1a40105dceULL, 0x1170cb642b133e8dULL },
+    { 0xfd9b0b20d0147542ULL, 0x15ccfe3d35d80e30ULL },
+    { 0x3d01cde904199292ULL, 0x1b403dcc834e11bdULL },
+    { 0x462120b1a28ffb9bULL, 0x1108269fd210cb16ULL },
+    { 0xd7a968de0b33fa82ULL, 0x154a3047c694fddbULL },
+    { 0xcd93c3158e00f923ULL, 0x1a9cbc59b83a3d52ULL },
+    { 0xc07c59ed78c09bb6ULL, 0x10a1f5b813246653ULL },
+    { 0xb09b7068d6f0c2a3ULL, 0x14ca732617ed7fe8ULL },
+    { 0xdcc24c830cacf34cULL, 0x19fd0fef9de8dfe2ULL },
+    { 0xc9f96fd1e7ec180fULL, 0x103e29f5c2b18bedULL },
+    { 0x3c77cbc661e71e13ULL, 0x144db473335deee9ULL },
+    { 0x8b95beb7fa60e598ULL, 0x1961219000356aa3ULL },
+    { 0x6e7b2e65f8f91efeULL, 0x1fb969f40042c54cULL },
+    { 0xc50cfcffbb9bb35fULL, 0x13d3e2388029bb4fULL },
+    { 0xb6503c3faa82a037ULL, 0x18c8dac6a0342a23ULL },
+    { 0xa3e44b4f95234844ULL, 0x1efb1178484134acULL },
+    { 0xe66eaf11bd360d2bULL, 0x135ceaeb2d28c0ebULL },
+    { 0xe00a5ad62c839075ULL, 0x183425a5f872f126ULL },
+    { 0x980cf18bb7a47493ULL, 0x1e412f0f768fad70ULL },
+    { 0x5f0816f752c6c8dcULL, 0x12e8bd69aa19cc66ULL },
+    { 0xf6ca1cb527787b13ULL, 0x17a2ecc414a03f7fULL },
+    { 0xf47ca3e2715699d7ULL, 0x1d8ba7f519c84f5fULL },
+    { 0xf8cde66d86d62026ULL, 0x127748f9301d319bULL },
+    { 0xf7016008e88ba830ULL, 0x17151b377c247e02ULL },
+    { 0xb4c1b80b22ae923cULL, 0x1cda62055b2d9d83ULL },
+    { 0x50f91306f5ad1b65ULL, 0x12087d4358fc8272ULL },
+    { 0xe53757c8b318623fULL, 0x168a9c942f3ba30eULL },
+    { 0x9e852dbadfde7acfULL, 0x1c2d43b93b0a8bd2ULL },
+    { 0xa3133c94cbeb0cc1ULL, 0x119c4a53c4e69763ULL },
+    { 0x8bd80bb9fee5cff1ULL, 0x16035ce8b6203d3cULL },
+    { 0xaece0ea87e9f43eeULL, 0x1b843422e3a84c8bULL },
+    { 0x4d40c9294f238a75ULL, 0x1132a095ce492fd7ULL },
+    { 0x2090fb73a2ec6d12ULL, 0x157f48bb41db7bcdULL },
+    { 0x68b53a508ba78856ULL, 0x1adf1aea12525ac0ULL },
+    { 0x417144725748b536ULL, 0x10cb70d24b7378b8ULL },
+    { 0x51cd958eed1ae283ULL, 0x14fe4d06de5056e6ULL },
+    { 0xe640faf2a8619b24ULL, 0x1a3de04895e46c9fULL },
+    { 0xefe89cd7a93d00f7ULL, 0x1066ac2d5daec3e3ULL },
+    { 0xebe2c40d938c4134ULL, 0x14805738b51a74dcULL },
+    { 0x26db7510f86f5181ULL, 0x19a06d06e2611214ULL },
+    { 0x9849292a9b4592f1ULL, 0x100444244d7cab4cULL },
+    { 0xbe5b73754216f7adULL, 0x1405552d60dbd61fULL },
+    { 0xadf25052929cb598ULL, 0x1906aa78b912cba7ULL },
+    { 0x996ee4673743e2ffULL, 0x1f485516e7577e91ULL },
+    { 0xffe54ec0828a6ddfULL, 0x138d352e5096af1aULL },
+    { 0xbfdea270a32d0957ULL, 0x18708279e4bc5ae1ULL },
+    { 0x2fd64b0ccbf84badULL, 0x1e8ca3185deb719aULL },
+    { 0x5de5eee7ff7b2f4cULL, 0x1317e5ef3ab32700ULL },
+    { 0x755f6aa1ff59fb1fULL, 0x17dddf6b095ff0c0ULL },
+    { 0x92b7454a7f3079e7ULL, 0x1dd55745cbb7ecf0ULL },
+    { 0x5bb28b4e8f7e4c30ULL, 0x12a5568b9f52f416ULL },
+    { 0xf29f2e22335ddf3cULL, 0x174eac2e8727b11bULL },
+    { 0xef46f9aac035570bULL, 0x1d22573a28f19d62ULL },
+    { 0xd58c5c0ab8215667ULL, 0x123576845997025dULL },
+    { 0x4aef730d6629ac01ULL, 0x16c2d4256ffcc2f5ULL },
+    { 0x9dab4fd0bfb41701ULL, 0x1c73892ecbfbf3b2ULL },
+    { 0xa28b11e277d08e60ULL, 0x11c835bd3f7d784fULL },
+    { 0x8b2dd65b15c4b1f9ULL, 0x163a432c8f5cd663ULL },
+    { 0x6df94bf1db35de77ULL, 0x1bc8d3f7b3340bfcULL },
+    { 0xc4bbcf772901ab0aULL, 0x115d847ad000877dULL },
+    { 0x35eac354f34215cdULL, 0x15b4e5998400a95dULL },
+    { 0x8365742a30129b40ULL, 0x1b221effe500d3b4ULL },
+    { 0xd21f689a5e0ba108ULL, 0x10f5535fef208450ULL },
+    { 0x06a742c0f58e894aULL, 0x1532a837eae8a565ULL },
+    { 0x4851137132f22b9dULL, 0x1a7f5245e5a2cebeULL },
+    { 0xed32ac26bfd75b42ULL, 0x108f936baf85c136ULL },
+    { 0xa87f57306fcd3212ULL, 0x14b378469b673184ULL },
+    { 0xd29f2cfc8bc07e97ULL, 0x19e056584240fde5ULL },
+    { 0xa3a37c1dd7584f1eULL, 0x102c35f729689eafULL },
+    { 0x8c8c5b254d2e62e6ULL, 0x14374374f3c2c65bULL },
+    { 0x6faf71eea079fb9fULL, 0x1945145230b377f2ULL },
+    { 0x0b9b4e6a48987a87ULL, 0x1f965966bce055efULL },
+    { 0x674111026d5f4c94ULL, 0x13bdf7e0360c35b5ULL },
+    { 0xc111554308b71fbaULL, 0x18ad75d8438f4322ULL },
+    { 0x7155aa93cae4e7a8ULL, 0x1ed8d34e547313ebULL },
+    { 0x26d58a9c5ecf10c9ULL, 0x13478410f4c7ec73ULL },
+    { 0xf08aed437682d4fbULL, 0x1819651531f9e78fULL },
+    { 0xecada89454238a3aULL, 0x1e1fbe5a7e786173ULL },
+    { 0x73ec895cb4963664ULL, 0x12d3d6f88f0b3ce8ULL },
+    { 0x90e7abb3e1bbc3fdULL, 0x1788ccb6b2ce0c22ULL },
+    { 0x352196a0da2ab4fdULL, 0x1d6affe45f818f2bULL },
+    { 0x0134fe24885ab11eULL, 0x1262dfeebbb0f97bULL },
+    { 0xc1823dadaa715d65ULL, 0x16fb97ea6a9d37d9ULL },
+    { 0x31e2cd19150db4bfULL, 0x1cba7de5054485d0ULL },
+    { 0x1f2dc02fad2890f7ULL, 0x11f48eaf234ad3a2ULL },
+    { 0xa6f9303b9872b535ULL, 0x1671b25aec1d888aULL },
+    { 0x50b77c4a7e8f6282ULL, 0x1c0e1ef1a724eaadULL },
+    { 0x5272adae8f199d91ULL, 0x1188d357087712acULL },
+    { 0x670f591a32e004f6ULL, 0x15eb082cca94d757ULL },
+    { 0x40d32f60bf980633ULL, 0x1b65ca37fd3a0d2dULL },
+    { 0x4883fd9c77bf03e0ULL, 0x111f9e62fe44483cULL },
+    { 0x5aa4fd0395aec4d8ULL, 0x156785fbbdd55a4bULL },
+    { 0x314e3c447b1a760eULL, 0x1ac1677aad4ab0deULL },
+    { 0xded0e5aaccf089c9ULL, 0x10b8e0acac4eae8aULL },
+    { 0x96851f15802cac3bULL, 0x14e718d7d7625a2dULL },
+    { 0xfc2666dae037d74aULL, 0x1a20df0dcd3af0b8ULL },
+    { 0x9d980048cc22e68eULL, 0x10548b68a044d673ULL },
+    { 0x84fe005aff2ba032ULL, 0x1469ae42c8560c10ULL },
+    { 0xa63d8071bef6883eULL, 0x198419d37a6b8f14ULL },
+    { 0xcfcce08e2eb42a4eULL, 0x1fe52048590672d9ULL },
+    { 0x21e00c58dd309a70ULL, 0x13ef342d37a407c8ULL },
+    { 0x2a580f6f147cc10dULL, 0x18eb0138858d09baULL },
+    { 0xb4ee134ad99bf150ULL, 0x1f25c186a6f04c28ULL },
+    { 0x7114cc0ec80176d2ULL, 0x137798f428562f99ULL },
+    { 0xcd59ff127a01d486ULL, 0x18557f31326bbb7fULL },
+    { 0xc0b07ed7188249a8ULL, 0x1e6adefd7f06aa5fULL },
+    { 0xd86e4f466f516e09ULL, 0x1302cb5e6f642a7bULL },
+    { 0xce89e3180b25c98bULL, 0x17c37e360b3d351aULL },
+    { 0x822c5bde0def3beeULL, 0x1db45dc38e0c8261ULL },
+    { 0xf15bb96ac8b58575ULL, 0x1290ba9a38c7d17cULL },
+    { 0x2db2a7c57ae2e6d2ULL, 0x1734e940c6f9c5dcULL },
+    { 0x391f51b6d99ba086ULL, 0x1d022390f8b83753ULL },
+    { 0x03b3931248014454ULL, 0x1221563a9b732294ULL },
+    { 0x04a077d6da019569ULL, 0x16a9abc9424feb39ULL },
+    { 0x45c895cc9081fac3ULL, 0x1c5416bb92e3e607ULL },
+    { 0x8b9d5d9fda513cbaULL, 0x11b48e353bce6fc4ULL },
+    { 0xae84b507d0e58be8ULL, 0x1621b1c28ac20bb5ULL },
+    { 0x1a25e249c51eeee3ULL, 0x1baa1e332d728ea3ULL },
+    { 0xf057ad6e1b33554dULL, 0x114a52dffc679925ULL },
+    { 0x6c6d98c9a2002aa1ULL, 0x159ce797fb817f6fULL },
+    { 0x4788fefc0a803549ULL, 0x1b04217dfa61df4bULL },
+    { 0x0cb59f5d8690214eULL, 0x10e294eebc7d2b8fULL },
+    { 0xcfe30734e83429a1ULL, 0x151b3a2a6b9c7672ULL },
+    { 0x83dbc9022241340aULL, 0x1a6208b50683940fULL },
+    { 0xb2695da15568c086ULL, 0x107d457124123c89ULL },
+    { 0x1f03b509aac2f0a7ULL, 0x149c96cd6d16cbacULL },
+    { 0x26c4a24c1573acd1ULL, 0x19c3bc80c85c7e97ULL },
+    { 0x783ae56f8d684c03ULL, 0x101a55d07d39cf1eULL },
+    { 0x16499ecb70c25f03ULL, 0x1420eb449c8842e6ULL },
+    { 0x9bdc067e4cf2f6c4ULL, 0x19292615c3aa539fULL },
+    { 0x82d3081de02fb476ULL, 0x1f736f9b3494e887ULL },
+    { 0xb1c3e512ac1dd0c9ULL, 0x13a825c100dd1154ULL },
+    { 0xde34de57572544fcULL, 0x18922f31411455a9ULL },
+    { 0x55c215ed2cee963bULL, 0x1eb6bafd91596b14ULL },
+    { 0xb5994db43c151de5ULL, 0x133234de7ad7e2ecULL },
+    { 0xe2ffa1214b1a655eULL, 0x17fec216198ddba7ULL },
+    { 0xdbbf89699de0feb6ULL, 0x1dfe729b9ff15291ULL },
+    { 0x2957b5e202ac9f31ULL, 0x12bf07a143f6d39bULL },
+    { 0xf3ada35a8357c6feULL, 0x176ec98994f48881ULL },
+    { 0x70990c31242db8bdULL, 0x1d4a7bebfa31aaa2ULL },
+    { 0x865fa79eb69c9376ULL, 0x124e8d737c5f0aa5ULL },
+    { 0xe7f791866443b854ULL, 0x16e230d05b76cd4eULL },
+    { 0xa1f575e7fd54a669ULL, 0x1c9abd04725480a2ULL },
+    { 0xa53969b0fe54e801ULL, 0x11e0b622c774d065ULL },
+    { 0x0e87c41d3dea2202ULL, 0x1658e3ab7952047fULL },
+    { 0xd229b5248d64aa82ULL, 0x1bef1c9657a6859eULL },
+    { 0x435a1136d85eea91ULL, 0x117571ddf6c81383ULL },
+    { 0x143095848e76a536ULL, 0x15d2ce55747a1864ULL },
+    { 0x193cbae5b2144e83ULL, 0x1b4781ead1989e7dULL },
+    { 0x2fc5f4cf8f4cb112ULL, 0x110cb132c2ff630eULL },
+    { 0xbbb77203731fdd56ULL, 0x154fdd7f73bf3bd1ULL },
+    { 0x2aa54e844fe7d4acULL, 0x1aa3d4df50af0ac6ULL },
+    { 0xdaa75112b1f0e4ebULL, 0x10a6650b926d66bbULL },
+    { 0xd15125575e6d1e26ULL, 0x14cffe4e7708c06aULL },
+    { 0x85a56ead360865b0ULL, 0x1a03fde214caf085ULL },
+    { 0x7387652c41c53f8eULL, 0x10427ead4cfed653ULL },
+    { 0x50693e7752368f71ULL, 0x14531e58a03e8be8ULL },
+    { 0x64838e1526c4334eULL, 0x1967e5eec84e2ee2ULL },
+    { 0xfda4719a70754022ULL, 0x1fc1df6a7a61ba9aULL },
+    { 0xde86c70086494815ULL, 0x13d92ba28c7d14a0ULL },
+    { 0x162878c0a7db9a1aULL, 0x18cf768b2f9c59c9ULL },
+    { 0x5bb296f0d1d280a1ULL, 0x1f03542dfb83703bULL },
+    { 0x194f9e5683239064ULL, 0x1362149cbd322625ULL },
+    { 0x5fa385ec23ec747eULL, 0x183a99c3ec7eafaeULL },
+    { 0xf78c67672ce7919dULL, 0x1e494034e79e5b99ULL },
+    { 0x3ab7c0a07c10bb02ULL, 0x12edc82110c2f940ULL },
+    { 0x4965b0c89b14e9c3ULL, 0x17a93a2954f3b790ULL },
+    { 0x5bbf1cfac1da2433ULL, 0x1d9388b3aa30a574ULL },
+    { 0xb957721cb92856a0ULL, 0x127c35704a5e6768ULL },
+    { 0xe7ad4ea3e7726c48ULL, 0x171b42cc5cf60142ULL },
+    { 0xa198a24ce14f075aULL, 0x1ce2137f74338193ULL },
+    { 0x44ff65700cd16498ULL, 0x120d4c2fa8a030fcULL },
+    { 0x563f3ecc1005bdbeULL, 0x16909f3b92c83d3bULL },
+    { 0x2bcf0e7f14072d2eULL, 0x1c34c70a777a4c8aULL },
+    { 0x5b61690f6c847c3dULL, 0x11a0fc668aac6fd6ULL },
+    { 0xf239c35347a59b4cULL, 0x16093b802d578bcbULL },
+    { 0xeec83428198f021fULL, 0x1b8b8a6038ad6ebeULL },
+    { 0x553d20990ff96153ULL, 0x1137367c236c6537ULL },
+    { 0x2a8c68bf53f7b9a8ULL, 0x1585041b2c477e85ULL },
+    { 0x752f82ef28f5a812ULL, 0x1ae64521f7595e26ULL },
+    { 0x093db1d57999890bULL, 0x10cfeb353a97dad8ULL },
+    { 0x0b8d1e4ad7ffeb4eULL, 0x1503e602893dd18eULL },
+    { 0x8e7065dd8dffe622ULL, 0x1a44df832b8d45f1ULL },
+    { 0xf9063faa78bfefd5ULL, 0x106b0bb1fb384bb6ULL },
+    { 0xb747cf9516efebcaULL, 0x1485ce9e7a065ea4ULL },
+    { 0xe519c37a5cabe6bdULL, 0x19a742461887f64dULL },
+    { 0xaf301a2c79eb7036ULL, 0x1008896bcf54f9f0ULL },
+    { 0xdafc20b798664c43ULL, 0x140aabc6c32a386cULL },
+    { 0x11bb28e57e7fdf54ULL, 0x190d56b873f4c688ULL },
+    { 0x1629f31ede1fd72aULL, 0x1f50ac6690f1f82aULL },
+    { 0x4dda37f34ad3e67aULL, 0x13926bc01a973b1aULL },
+    { 0xe150c5f01d88e019ULL, 0x187706b0213d09e0ULL },
+    { 0x19a4f76c24eb181fULL, 0x1e94c85c298c4c59ULL },
+    { 0xb0071aa39712ef13ULL, 0x131cfd3999f7afb7ULL },
+    { 0x9c08e14c7cd7aad8ULL, 0x17e43c8800759ba5ULL },
+    { 0x030b199f9c0d958eULL, 0x1ddd4baa0093028fULL },
+    { 0x61e6f003c1887d79ULL, 0x12aa4f4a405be199ULL },
+    { 0xba60ac04b1ea9cd7ULL, 0x1754e31cd072d9ffULL },
+    { 0xa8f8d705de65440dULL, 0x1d2a1be4048f907fULL },
+    { 0xc99b8663aaff4a88ULL, 0x123a516e82d9ba4fULL },
+    { 0xbc0267fc95bf1d2aULL, 0x16c8e5ca239028e3ULL },
+    { 0xab0301fbbb2ee474ULL, 0x1c7b1f3cac74331cULL },
+    { 0xeae1e13d54fd4ec9ULL, 0x11ccf385ebc89ff1ULL },
+    { 0x659a598caa3ca27bULL, 0x1640306766bac7eeULL },
+    { 0xff00efefd4cbcb1aULL, 0x1bd03c81406979e9ULL },
+    { 0x3f6095f5e4ff5ef0ULL, 0x116225d0c841ec32ULL },
+    { 0xcf38bb735e3f36acULL, 0x15baaf44fa52673eULL },
+    { 0x8306ea5035cf0457ULL, 0x1b295b1638e7010eULL },
+    { 0x11e4527221a162b6ULL, 0x10f9d8ede39060a9ULL },
+    { 0x565d670eaa09bb64ULL, 0x15384f295c7478d3ULL },
+    { 0x2bf4c0d2548c2a3dULL, 0x1a8662f3b3919708ULL },
+    { 0x1b78f88374d79a66ULL, 0x1093fdd8503afe65ULL },
+    { 0x625736a4520d8100ULL, 0x14b8fd4e6449bdfeULL },
+    { 0xfaed044d6690e140ULL, 0x19e73ca1fd5c2d7dULL },
+    { 0xbcd422b0601a8cc8ULL, 0x103085e53e599c6eULL },
+    { 0x6c092b5c78212ffaULL, 0x143ca75e8df0038aULL },
+    { 0x070b763396297bf8ULL, 0x194bd136316c046dULL },
+    { 0x48ce53c07bb3daf6ULL, 0x1f9ec583bdc70588ULL },
+    { 0x2d80f4584d5068daULL, 0x13c33b72569c6375ULL },
+    { 0x78e1316e60a48310ULL, 0x18b40a4eec437c52ULL }
+};
+
+static inline cxuint pow5BitsShortest(int e)
+{ return ((e*1217359)>>19) + 1; }
+
+static inline int log10Pow2Shortest(int e)
+{ return (e*78913)>>18; }
+
+static inline int log10Pow5Shortest(int e)
+{ return (e*732923)>>20; }
+
+static inline bool multipleOfPow5Shortest(uint64_t value, int p)
+{
+    int count = 0;
+    for (; value % 5 == 0 && count < p; count++)
+        value /= 5;
+    return count >= p;
+}
+
+/* (m*mul) >> shift, where shift is in range 64-127 */
+static inline uint64_t mulShiftShortest(uint64_t m, const uint64_t* mul, cxuint shift)
+{
+    uint64_t lo[2], hi[2];
+    mul64Full(m, mul[0], lo);
+    mul64Full(m, mul[1], hi);
+    hi[0] += lo[1];
+    hi[1] += (hi[0] < lo[1]);
+    shift -= 64;
+    return (shift != 0) ? (hi[0]>>shift) | (hi[1]<<(64-shift)) : hi[0];
+}
+
+/* compute shortest decimal value (decValue*10**decExp) that parsed gives
+ * same floating point value */
+static void fXtoShortestDecimal(uint64_t ieeeMantisa, cxuint ieeeExp, cxuint expBias,
+            cxuint mantisaBits, uint64_t& decValue, int& decExp)
+{
+    int e2;
+    uint64_t m2;
+    if (ieeeExp == 0)
+    {   // denormalized
+        e2 = 1 - int(expBias) - int(mantisaBits) - 2;
+        m2 = ieeeMantisa;
+    }
+    else
+    {
+        e2 = int(ieeeExp) - int(expBias) - int(mantisaBits) - 2;
+        m2 = (1ULL<<mantisaBits) | ieeeMantisa;
+    }
+    const bool acceptBounds = (m2&1) == 0; // round to nearest even when parsing
+    
+    // bounds of rounding interval: vm < vr < vp (in 4*m2 units)
+    const uint64_t mv = m2<<2;
+    const cxuint mmShift = (ieeeMantisa != 0 || ieeeExp <= 1);
+    uint64_t vr, vp, vm;
+    int e10;
+    bool vmIsTrailingZeros = false;
+    bool vrIsTrailingZeros = false;
+    if (e2 >= 0)
+    {
+        const int q = log10Pow2Shortest(e2) - (e2 > 3);
+        e10 = q;
+        const cxuint shift = -e2 + q + 125 + pow5BitsShortest(q) - 1;
+        const uint64_t* mul = pow5InvShortestTable[q];
+        vr = mulShiftShortest(mv, mul, shift);
+        vp = mulShiftShortest(mv+2, mul, shift);
+        vm = mulShiftShortest(mv-1-mmShift, mul, shift);
+        if (q <= 21)
+        {   // only one of mp, mv, mm can be multiple of 5
+            if (mv % 5 == 0)
+                vrIsTrailingZeros = multipleOfPow5Shortest(mv, q);
+            else if (acceptBounds)
+                vmIsTrailingZeros = multipleOfPow5Shortest(mv-1-mmShift, q);
+            else
+                vp -= multipleOfPow5Shortest(mv+2, q);
+        }
+    }
+    else
+    {
+        const int q = log10Pow5Shortest(-e2) - (-e2 > 1);
+        e10 = q + e2;
+        const int i = -e2 - q;
+        const cxuint shift = q - (int(pow5BitsShortest(i)) - 125);
+        const uint64_t* mul = pow5ShortestTable[i];
+        vr = mulShiftShortest(mv, mul, shift);
+        vp = mulShiftShortest(mv+2, mul, shift);
+        vm = mulShiftShortest(mv-1-mmShift, mul, shift);
+        if (q <= 1)
+        {   // mv has at least q trailing zero bits
+            vrIsTrailingZeros = true;
+            if (acceptBounds)
+                vmIsTrailingZeros = (mmShift == 1);
+            else
+                vp--;
+        }
+        else if (q < 63)
+            vrIsTrailingZeros = (mv & ((1ULL<<q)-1)) == 0;
+    }
+    
+    // remove digits while rounding interval contains shorter values
+    int removed = 0;
+    cxuint lastRemovedDigit = 0;
+    if (vmIsTrailingZeros || vrIsTrailingZeros)
+    {   // rare case (exact values)
+        for (; vp/10 > vm/10; removed++)
+        {
+            vmIsTrailingZeros &= (vm % 10 == 0);
+            vrIsTrailingZeros &= (lastRemovedDigit == 0);
+            lastRemovedDigit = vr % 10;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+        }
+        if (vmIsTrailingZeros)
+            for (; vm % 10 == 0; removed++)
+            {
+                vrIsTrailingZeros &= (lastRemovedDigit == 0);
+                lastRemovedDigit = vr % 10;
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+            }
+        if (vrIsTrailingZeros && lastRemovedDigit == 5 && (vr&1) == 0)
+            lastRemovedDigit = 4; // exact half, round to even
+        decValue = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) ||
+                lastRemovedDigit >= 5);
+    }
+    else
+    {   // common case
+        bool roundUp = false;
+        if (vp/100 > vm/100)
+        {
+            roundUp = (vr % 100 >= 50);
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        for (; vp/10 > vm/10; removed++)
+        {
+            roundUp = (vr % 10 >= 5);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+        }
+        decValue = vr + (vr == vm || roundUp);
+    }
+    decExp = e10 + removed;
+}
+
+static size_t fXtocstrCStyle(uint64_t value, char* str, size_t maxSize,
+        bool scientific, bool shortest, cxuint expBits, cxuint mantisaBits)
+{
+    char* p = str;
+    bool signOfValue = ((value>>(expBits+mantisaBits))!=0);
+    const cxuint expMask = ((1U<<expBits)-1U);
+    const uint64_t mantisaMask = (1ULL<<mantisaBits)-1ULL;
+    
+    if (((value >> mantisaBits)&expMask) == expMask)
+    {   // infinity or nans
+        if (signOfValue)
+        {
+            if (maxSize < 5)
+                throw Exception("Max size is too small");
+            *p++ = '-';
+        }
+        else if (maxSize < 4)
+            throw Exception("Max size is too small");
+        
+        if ((value&mantisaMask) != 0)
+        {   /* nan */
+            *p++ = 'n';
+            *p++ = 'a';
+            *p++ = 'n';
+        }
+        else
+        {   /* infinity */
+            *p++ = 'i';
+            *p++ = 'n';
+            *p++ = 'f';
+        }
+        *p = 0;
+        return p-str;
+    }
+    
+    uint64_t mantisa = value&mantisaMask;
+    const int minExpNonDenorm = -((1U<<(expBits-1))-2);
+    const int binaryExp = ((value>>mantisaBits)&expMask) - (expMask>>1);
+    
+    if (mantisa == 0 && binaryExp == minExpNonDenorm-1)
+    {   /* if zero */
+        if (signOfValue)
+        {
+            if (maxSize < 3)
+                throw Exception("Max size is too small");
+            *p++ = '-';
+        }
+        else if (maxSize < 2)
+            throw Exception("Max size is too small");
+        *p++ = '0';
+        if (scientific)
+        {
+            if (p+3 >= str + maxSize)
+                throw Exception("Max size is too small");
+            *p++='e';
+            *p++='+';
+            *p++='0';
+        }   
+        *p = 0;
+        return p-str;
+    }
+    
+    cxuint significantBits = 0;
+    if (binaryExp >= minExpNonDenorm)
+    {   /* normalized value */
+        significantBits = mantisaBits;
+        mantisa |= 1ULL<<mantisaBits;
+    }
+    else /* if value is denormalized */
         significantBits = 63 - CLZ64(mantisa);
     
-    /* binExpOfValue - exponent for binaryValue (in integer form).
-     * binaryExp - mantisaBits - for normalized values
-     * binaryExp - mantisaBits + 1 - for denormalized form. adds 1 because integer of
-     *   denormalized value is in fraction part (mantisa) binaryExp is -expMask/2.
-     */
-    const int binExpOfValue = binaryExp-mantisaBits+(binaryExp < minExpNonDenorm);
-    // decimal exponent for value plus one for extraneous digit
-    const int decExpOfValue = log2ByLog10Round(binExpOfValue)-1;
-    // binary exponent for
-    const int reqBinExpOfValue = log10ByLog2Floor(decExpOfValue);
-    const cxuint mantisaShift = (62-significantBits);
-    mantisa = mantisa<<mantisaShift;
+    /* binExpOfValue - exponent for binaryValue (in integer form).
+     * binaryExp - mantisaBits - for normalized values
+     * binaryExp - mantisaBits + 1 - for denormalized form. adds 1 because integer of
+     *   denormalized value is in fraction part (mantisa) binaryExp is -expMask/2.
+     */
+    const int binExpOfValue = binaryExp-mantisaBits+(binaryExp < minExpNonDenorm);
+    // decimal exponent for value plus one for extraneous digit
+    const int decExpOfValue = log2ByLog10Round(binExpOfValue)-1;
+    if (shortest)
+    {
+        uint64_t decValue;
+        int decExp;
+        fXtoShortestDecimal(value&mantisaMask, (value>>mantisaBits)&expMask, expMask>>1,
+                    mantisaBits, decValue, decExp);
+        // same number of digits as in default mode (same form of printed value)
+        for (; decExp > decExpOfValue; decExp--)
+            decValue *= 10;
+        return fXtocstrPutDecimal(decValue, decExp, signOfValue, str, maxSize, scientific);
+    }
+    // binary exponent for
+    const int reqBinExpOfValue = log10ByLog2Floor(decExpOfValue);
+    const cxuint mantisaShift = (62-significantBits);
+    mantisa = mantisa<<mantisaShift;
+    
+    cxuint oneBitPos = mantisaShift - (binExpOfValue-reqBinExpOfValue);
+    
+    uint64_t pow5[2];
+    uint64_t rescaled[4];
+    cxuint powSize;
+    cxint pow5Exp;
+    // generate rescaled value
+    if (decExpOfValue != 0)
+    {
+        const uint64_t inMantisa[2] = { 0, mantisa };
+        bigPow5(-decExpOfValue, 2, powSize, pow5Exp, pow5);
+        if (powSize == 2)
+            bigMulFixed<2, 2>(pow5, inMantisa, rescaled);
+        else
+            bigMulFixed<1, 2>(pow5, inMantisa, rescaled);
+        rescaled[powSize+1] += mantisa;
+        oneBitPos++;
+    }
+    else
+    {   /* if one */
+        powSize = 1;
+        pow5[0] = 0;
+        rescaled[0] = rescaled[1] = 0;
+        rescaled[2] = mantisa;
+    }
+    
+    const uint64_t oneValue = 1ULL<<oneBitPos;
+    uint64_t decValue = rescaled[powSize+1]>>oneBitPos;
+    
+    bool roundingFix = false;
+    /* fix for rounding to ten */
+    const cxuint mod = (decValue) % 100;
+    /* check rounding digits */
+    if (mod >= 82 || (mod <= 18 && mod != 0))
+    {   // check higher round
+        uint64_t rescaledHalf[4];
+        // rescaled half (ULP) minus rescaled max error + 1
+        rescaledHalf[0] = 0;
+        rescaledHalf[1] = pow5[0]<<(mantisaShift-1);
+        rescaledHalf[2] = pow5[0]>>(64-mantisaShift+1);
+        if (powSize == 2)
+        {
+            rescaledHalf[2] |= pow5[1]<<(mantisaShift-1);
+            rescaledHalf[3] = pow5[1]>>(64-mantisaShift+1);
+        }
+        rescaledHalf[powSize+1] |= (1ULL<<(mantisaShift-1));
+        
+        if (-decExpOfValue < 0 || -decExpOfValue > 55)
+        {   // if not exact pow5 (rescaled value is not exact value)
+            // compute max error of rescaled value ((0.5 + 2**-29)*mantisa)
+            const uint64_t maxRescaledError[2] = 
+            { mantisa<<(64-30), (mantisa>>1) + (mantisa>>30) };
+            if (powSize == 2)
+                bigSubFixed<4, 2>(rescaledHalf, maxRescaledError);
+            else
+                bigSubFixed<3, 2>(rescaledHalf, maxRescaledError);
+        }
+        const uint64_t one64 = 1; // preserve rounding for exact half case
+        if (powSize == 2)
+            bigSubFixed<4, 1>(rescaledHalf, &one64);
+        else
+            bigSubFixed<3, 1>(rescaledHalf, &one64);
+        
+        if (mod >= 82)
+        {   // we must add some bits
+            uint64_t toAdd[4] = { 0, 0, 0, 0 };
+            // (100-mod) - (rest from value beginning one) - value to add
+            toAdd[powSize+1] = ((100ULL-uint64_t(mod))<<oneBitPos) +
+                    (rescaled[powSize+1] & ~(oneValue-1));
+            bool borrow;
+            if (powSize == 2)
+            {
+                bigSubFixed<4, 4>(toAdd, rescaled);
+                // check if half changed
+                borrow = bigSubFixed<4, 4>(rescaledHalf, toAdd);
+            }
+            else
+            {
+                bigSubFixed<3, 3>(toAdd, rescaled);
+                borrow = bigSubFixed<3, 3>(rescaledHalf, toAdd);
+            }
+            if (!borrow)
+            {   // if toAdd is smaller than rescaledHalf
+                decValue += (100-mod);
+                roundingFix = true;
+            }
+        }
+        else if (mod <= 18)
+        {   // we must subtract some bits
+            uint64_t toSub[4];
+            // value to subtract
+            toSub[powSize+1] = (uint64_t(mod)<<oneBitPos) |
+                    (rescaled[powSize+1]&(oneValue-1));
+            toSub[0] = rescaled[0];
+            if (powSize == 2)
+                toSub[1] = rescaled[1];
+            toSub[powSize] = rescaled[powSize];
+            // check if half changed
+            const bool borrow = (powSize == 2) ?
+                    bigSubFixed<4, 4>(rescaledHalf, toSub) :
+                    bigSubFixed<3, 3>(rescaledHalf, toSub);
+            if (!borrow)
+            {   // if toSub is smaller than rescaledHalf
+                decValue -= mod;
+                roundingFix = true;
+            }
+        }
+    }
+    
+    /* fix for rounding to one (to nearest value) (if not rounding zeros) */
+    if (!roundingFix && mod != 0 &&
+        ((rescaled[powSize+1] & (oneValue-1)) >= (oneValue>>1)))
+        decValue++;
+    
+    return fXtocstrPutDecimal(decValue, decExpOfValue, signOfValue, str, maxSize,
+                scientific);
+}
+
+/*
+ * fixed precision formatting (like printf with %.Nf and %.Ne)
+ */
+
+/* multiply number (size limbs) by single 64-bit value (tmp has size+1 limbs) */
+static inline cxuint bigMulSingleExact(cxuint size, uint64_t* number, uint64_t value,
+            uint64_t* tmp)
+{
+    bigMul(size, number, 1, &value, tmp);
+    size += (tmp[size] != 0);
+    std::copy(tmp, tmp+size, number);
+    return size;
+}
+
+/* exact value of m*5**power (power > 0). 5**power is computed by repeated squaring of
+ * 5**27 (single limb), so cost is dominated by last squaring (subquadratic bigMul).
+ * number must have space for result+2 limbs, tmp for twice this size.
+ * returns size of result in limbs */
+static cxuint bigMulPow5Exact(uint64_t m, cxuint power, uint64_t* number, uint64_t* tmp)
+{
+    const uint64_t pow5By27 = 7450580596923828125ULL; // 5**27
+    const cxuint highPower = power/27;
+    cxuint size = 1;
+    number[0] = 1;
+    if (highPower != 0)
+    {
+        number[0] = pow5By27;
+        for (cxint bit = 30-CLZ32(highPower); bit >= 0; bit--)
+        {   // square and multiply
+            bigMul(size, number, size, number, tmp);
+            size <<= 1;
+            while (tmp[size-1] == 0)
+                size--;
+            std::copy(tmp, tmp+size, number);
+            if (((highPower>>bit)&1) != 0)
+                size = bigMulSingleExact(size, number, pow5By27, tmp);
+        }
+    }
+    const cxuint rest = power%27;
+    if (rest > 19)
+        size = bigMulSingleExact(size, number, power10sTable[19]>>19, tmp);
+    const cxuint restStep = (rest > 19) ? rest-19 : rest;
+    if (restStep != 0)
+        size = bigMulSingleExact(size, number, power10sTable[restStep]>>restStep, tmp);
+    return bigMulSingleExact(size, number, m, tmp);
+}
+
+/* exact decimal digits of m*2**e (value = digits*10**decExp, without leading zeroes) */
+static void fXtoExactDigits(uint64_t m, int e, std::vector<char>& digits, int64_t& decExp)
+{
+    // using vector for prevents memory leaks (function can throw exception)
+    std::vector<uint64_t> number;
+    cxuint size;
+    if (e >= 0)
+    {   // integer value: m<<e
+        size = (e>>6) + 2;
+        number.assign(size, 0);
+        number[e>>6] = m << (e&63);
+        if ((e&63) != 0)
+            number[(e>>6)+1] = m >> (64-(e&63));
+        decExp = 0;
+    }
+    else
+    {   // m*2**e = m*5**(-e) / 10**(-e)
+        const cxuint maxSize = (cxuint(-e)*2322)/64000 + 3;
+        number.assign((maxSize+2)*3, 0);
+        size = bigMulPow5Exact(m, -e, number.data(), number.data() + maxSize+2);
+        decExp = e;
+    }
+    digits.resize(size_t(size)*20 + 2);
+    const size_t digitsNum = bigtocstrCStyle(size, number.data(), digits.data(),
+                digits.size(), 10, 0, false);
+    digits.resize(digitsNum);
+}
+
+/* round decimal digits (value = digits*10**decExp) to position 10**lastExp
+ * (to nearest even). after rounding decExp is lastExp. exponents are 64-bit,
+ * because precision can be bigger than INT_MAX */
+static void fXtoRoundDigits(std::vector<char>& digits, int64_t& decExp, int64_t lastExp)
+{
+    if (lastExp <= decExp)
+    {   // no rounding
+        digits.insert(digits.end(), size_t(decExp-lastExp), '0');
+        decExp = lastExp;
+        return;
+    }
+    const size_t droppedNum = size_t(lastExp-decExp);
+    decExp = lastExp;
+    if (droppedNum > digits.size())
+    {   // value is smaller than half of 10**lastExp
+        digits.assign(1, '0');
+        return;
+    }
+    const size_t keptNum = digits.size()-droppedNum;
+    bool roundUp = false;
+    if (digits[keptNum] > '5')
+        roundUp = true;
+    else if (digits[keptNum] == '5')
+    {   // if half then round to even
+        roundUp = std::find_if(digits.begin()+keptNum+1, digits.end(),
+                [](char c) { return c != '0'; }) != digits.end() ||
+                (keptNum != 0 && ((digits[keptNum-1]-'0')&1) != 0);
+    }
+    digits.resize(keptNum);
+    if (roundUp)
+    {
+        size_t pos = keptNum;
+        for (; pos > 0 && digits[pos-1] == '9'; pos--)
+            digits[pos-1] = '0';
+        if (pos == 0)
+            digits.insert(digits.begin(), '1');
+        else
+            digits[pos-1]++;
+    }
+    if (digits.empty())
+        digits.assign(1, '0');
+}
+
+#ifdef HAVE_INT128
+/* fast path: round m*2**e/10**lastExp to nearest even in 128-bit arithmetic.
+ * returns false if result does not fit in 128-bit or power of 5 is too big */
+static bool fXtoFixedRound128(uint64_t m, int e, int lastExp, unsigned __int128& out)
+{
+    typedef unsigned __int128 UInt128;
+    if (lastExp < -19 || lastExp > 19)
+        return false;
+    const int shift = e - lastExp;
+    UInt128 num, den;
+    if (lastExp <= 0)
+    {   // m*5**(-lastExp) * 2**shift
+        num = UInt128(m) * (power10sTable[-lastExp]>>(-lastExp));
+        if (shift >= 0)
+        {
+            if (shift >= 128 || (shift != 0 && (num >> (128-shift)) != 0))
+                return false;
+            out = num << shift;
+            return true;
+        }
+        if (shift <= -128)
+        {   // num is smaller than 2**127
+            out = 0;
+            return true;
+        }
+        den = UInt128(1) << (-shift);
+    }
+    else
+    {   // m*2**shift / 5**lastExp
+        const uint64_t pow5 = power10sTable[lastExp]>>lastExp;
+        if (shift >= 0)
+        {
+            if (shift >= 64)
+                return false;
+            num = UInt128(m) << shift;
+            den = pow5;
+        }
+        else
+        {
+            if (shift <= -64)
+                return false;
+            num = m;
+            den = UInt128(pow5) << (-shift);
+        }
+    }
+    out = num / den;
+    const UInt128 rem = num - out*den;
+    // round to nearest even (den is smaller than 2**127)
+    if ((rem<<1) > den || ((rem<<1) == den && (out&1) != 0))
+        out++;
+    return true;
+}
+#endif
+
+/* put fixed formatted value: digits*10**(-precision) in fixed form or
+ * d.ddd*10**decExponent in scientific form (digits has precision+1 digits) */
+static size_t fXtocstrPutFixed(const char* digits, size_t digitsNum, bool signOfValue,
+            cxuint precision, bool scientific, int decExponent, char* str, size_t maxSize)
+{
+    char* p = str;
+    size_t length = size_t(signOfValue) + ((precision != 0) ? size_t(precision)+1 : 0);
+    cxuint expDigitsNum = 0;
+    char expBuffer[12];
+    if (!scientific)
+        length += (digitsNum > precision) ? digitsNum-precision : 1;
+    else
+    {   // exponent has at least two digits (like printf)
+        for (cxuint tmpExp = std::abs(decExponent); tmpExp != 0 || expDigitsNum < 2;
+             tmpExp /= 10)
+            expBuffer[expDigitsNum++] = '0' + tmpExp%10;
+        length += 3 + expDigitsNum;
+    }
+    if (length >= maxSize)
+        throw Exception("Max size is too small");
+    
+    if (signOfValue)
+        *p++ = '-';
+    if (!scientific)
+    {
+        if (digitsNum > precision)
+        {
+            std::copy(digits, digits + digitsNum-precision, p);
+            p += digitsNum-precision;
+        }
+        else
+            *p++ = '0';
+        if (precision != 0)
+        {
+            *p++ = '.';
+            if (digitsNum < precision)
+            {
+                std::fill(p, p + precision-digitsNum, '0');
+                p += precision-digitsNum;
+            }
+            const size_t fracDigitsNum = std::min(size_t(precision), digitsNum);
+            std::copy(digits + digitsNum-fracDigitsNum, digits + digitsNum, p);
+            p += fracDigitsNum;
+        }
+    }
+    else
+    {
+        *p++ = digits[0];
+        if (precision != 0)
+        {
+            *p++ = '.';
+            std::copy(digits+1, digits+1+precision, p);
+            p += precision;
+        }
+        *p++ = 'e';
+        *p++ = (decExponent < 0) ? '-' : '+';
+        for (cxuint pos = expDigitsNum; pos > 0; pos--)
+            *p++ = expBuffer[pos-1];
+    }
+    *p = 0;
+    return p-str;
+}
+
+static size_t fXtocstrFixedCStyle(uint64_t value, char* str, size_t maxSize,
+        cxuint precision, bool scientific, cxuint expBits, cxuint mantisaBits)
+{
+    const bool signOfValue = ((value>>(expBits+mantisaBits))!=0);
+    const cxuint expMask = ((1U<<expBits)-1U);
+    const uint64_t mantisaMask = (1ULL<<mantisaBits)-1ULL;
+    const cxuint ieeeExp = (value>>mantisaBits)&expMask;
+    
+    if (ieeeExp == expMask)
+    {   // infinity or nans
+        if (maxSize < 4U+signOfValue)
+            throw Exception("Max size is too small");
+        char* p = str;
+        if (signOfValue)
+            *p++ = '-';
+        ::memcpy(p, ((value&mantisaMask) != 0) ? "nan" : "inf", 4);
+        return p+3-str;
+    }
+    
+    // value = m*2**e
+    uint64_t m = value&mantisaMask;
+    int e = 1 - int(expMask>>1) - int(mantisaBits);
+    if (ieeeExp != 0)
+    {
+        m |= 1ULL<<mantisaBits;
+        e += ieeeExp-1;
+    }
+    
+    // using vector for prevents memory leaks (function can throw exception)
+    std::vector<char> digits;
+    int64_t decExp;
+    if (precision == FXTOCSTR_EXACT_PRECISION)
+    {   // all digits of exact value
+        if (m != 0)
+            fXtoExactDigits(m, e, digits, decExp);
+        else
+        {
+            digits.assign(1, '0');
+            decExp = 0;
+        }
+        for (; digits.size() > 1 && digits.back() == '0'; decExp++)
+            digits.pop_back();
+        precision = (!scientific) ? std::max(-decExp, int64_t(0)) : digits.size()-1;
+    }
+    // minimal length of output (digits, point if precision is nonzero and exponent)
+    if (size_t(precision) + (precision != 0) + (scientific ? 5 : 1) >= maxSize)
+        throw Exception("Max size is too small");
+    
+    if (m == 0)
+    {
+        digits.assign(size_t(precision)+1, '0');
+        return fXtocstrPutFixed(digits.data(), digits.size(), signOfValue, precision,
+                    scientific, 0, str, maxSize);
+    }
+    
+    int decExponent = 0;
+#ifdef HAVE_INT128
+    if (digits.empty() && precision <= 36)
+    {   // fast path (precision fits in int)
+        unsigned __int128 rounded;
+        bool fastDone;
+        if (!scientific)
+            fastDone = fXtoFixedRound128(m, e, -int(precision), rounded);
+        else
+        {   // estimate of decimal exponent (can be lower by one)
+            decExponent = log2ByLog10Floor(e + 63 - CLZ64(m));
+            unsigned __int128 maxValue = 10;
+            for (cxuint i = 0; i < precision; i++)
+                maxValue *= 10;
+            fastDone = fXtoFixedRound128(m, e, decExponent-int(precision), rounded);
+            if (fastDone && rounded >= maxValue)
+            {   // too many digits, decimal exponent is higher
+                decExponent++;
+                fastDone = fXtoFixedRound128(m, e, decExponent-int(precision), rounded);
+                if (rounded == maxValue) // rounding to next power of 10
+                {
+                    rounded /= 10;
+                    decExponent++;
+                }
+            }
+        }
+        if (fastDone)
+        {
+            char buffer[45];
+            const uint64_t limbs[2] = { uint64_t(rounded), uint64_t(rounded>>64) };
+            const size_t digitsNum = u128tocstrCStyle(limbs, buffer, 45);
+            return fXtocstrPutFixed(buffer, digitsNum, signOfValue, precision,
+                        scientific, decExponent, str, maxSize);
+        }
+    }
+#endif
+    // slow path: exact decimal expansion and rounding
+    if (digits.empty())
+        fXtoExactDigits(m, e, digits, decExp);
+    if (!scientific)
+        fXtoRoundDigits(digits, decExp, -int64_t(precision));
+    else
+    {
+        decExponent = decExp + int(digits.size()) - 1;
+        fXtoRoundDigits(digits, decExp, decExponent - int64_t(precision));
+        if (digits.size() > size_t(precision)+1)
+        {   // rounding to next power of 10
+            digits.pop_back();
+            decExponent++;
+        }
+    }
+    return fXtocstrPutFixed(digits.data(), digits.size(), signOfValue, precision,
+                scientific, decExponent, str, maxSize);
+}
+
+/* format value in hexadecimal form (like printf with '%a'): 0x1.XXXpE for normalized
+ * values, 0x0.XXXpE (with minimal exponent) for subnormals, trailing zeroes are removed */
+static size_t fXtocstrHexCStyle(uint64_t value, char* str, size_t maxSize,
+        cxuint expBits, cxuint mantisaBits)
+{
+    const bool signOfValue = ((value>>(expBits+mantisaBits))!=0);
+    const cxuint expMask = ((1U<<expBits)-1U);
+    const uint64_t mantisaMask = (1ULL<<mantisaBits)-1ULL;
+    const cxuint ieeeExp = (value>>mantisaBits)&expMask;
+    const cxint expBias = expMask>>1;
+    
+    if (ieeeExp == expMask)
+    {   // infinity or nans
+        if (maxSize < 4U+signOfValue)
+            throw Exception("Max size is too small");
+        char* p = str;
+        if (signOfValue)
+            *p++ = '-';
+        ::memcpy(p, ((value&mantisaMask) != 0) ? "nan" : "inf", 4);
+        return p+3-str;
+    }
+    
+    // fraction aligned to hexadecimal digits
+    const cxuint fracDigitsMax = (mantisaBits+3)>>2;
+    uint64_t frac = (value&mantisaMask) << ((fracDigitsMax<<2) - mantisaBits);
+    cxint exponent = 0;
+    if (ieeeExp != 0)
+        exponent = cxint(ieeeExp) - expBias;
+    else if (frac != 0)
+        exponent = 1 - expBias; // subnormal
+    cxuint fracDigitsNum = 0;
+    if (frac != 0)
+    {   // remove trailing zeroes
+        for (fracDigitsNum = fracDigitsMax; (frac&15) == 0; fracDigitsNum--)
+            frac >>= 4;
+    }
+    const cxuint absExponent = (exponent < 0) ? -exponent : exponent;
+    const cxuint expDigitsNum = (absExponent != 0) ? u64DecDigitsNum(absExponent) : 1;
+    
+    const size_t outLength = signOfValue + 3 + (fracDigitsNum != 0 ? fracDigitsNum+1 : 0) +
+            2 + expDigitsNum;
+    if (outLength >= maxSize)
+        throw Exception("Max size is too small");
+    
+    char* p = str;
+    if (signOfValue)
+        *p++ = '-';
+    *p++ = '0';
+    *p++ = 'x';
+    *p++ = (ieeeExp != 0) ? '1' : '0';
+    if (fracDigitsNum != 0)
+    {
+        *p++ = '.';
+        u64WriteHexDigits(frac, fracDigitsNum, p, false);
+        p += fracDigitsNum;
+    }
+    *p++ = 'p';
+    *p++ = (exponent < 0) ? '-' : '+';
+    u64WriteDecDigits(absExponent, expDigitsNum, p);
+    p += expDigitsNum;
+    *p = 0;
+    return p-str;
+}
+
+#ifdef HAVE_HALF_TABLES
+/* strings of all finite nonnegative half floats (generated at build time by
+ * genHalfTables). table is in read-only data, so it is paged in only when used */
+#include <NumStringConvHalfTables.inc>
+#endif
+
+size_t CLRX::htocstrCStyle(cxushort value, char* str, size_t maxSize, bool scientific)
+{
+#ifdef HAVE_HALF_TABLES
+    if ((value & 0x7c00) != 0x7c00)
+    {   // finite value: only copy string from table
+        const bool signOfValue = (value & 0x8000) != 0;
+        const char* row = halfStringsTable + (value & 0x7fff)*HALF_TABLE_ROW_SIZE;
+        const size_t length = (!scientific) ? ::strnlen(row, HALF_TABLE_HR_SIZE) :
+                ::strnlen(row + HALF_TABLE_HR_SIZE, HALF_TABLE_SC_SIZE);
+        if (signOfValue + length >= maxSize)
+            throw Exception("Max size is too small");
+        char* p = str;
+        if (signOfValue)
+            *p++ = '-';
+        ::memcpy(p, row + (scientific ? HALF_TABLE_HR_SIZE : 0), length);
+        p[length] = 0;
+        return p+length-str;
+    }
+#endif
+    return fXtocstrCStyle(value, str, maxSize, scientific, false, 5, 10);
+}
+
+size_t CLRX::ftocstrCStyle(float value, char* str, size_t maxSize, bool scientific)
+{
+    FloatUnion v;
+    v.f = value;
+    return fXtocstrCStyle(v.u, str, maxSize, scientific, false, 8, 23);
+}
+
+size_t CLRX::dtocstrCStyle(double value, char* str, size_t maxSize, bool scientific)
+{
+    DoubleUnion v;
+    v.d = value;
+    return fXtocstrCStyle(v.u, str, maxSize, scientific, false, 11, 52);
+}
+
+size_t CLRX::htocstrShortestCStyle(cxushort value, char* str, size_t maxSize,
+            bool scientific)
+{
+    return fXtocstrCStyle(value, str, maxSize, scientific, true, 5, 10);
+}
+
+size_t CLRX::ftocstrShortestCStyle(float value, char* str, size_t maxSize,
+            bool scientific)
+{
+    FloatUnion v;
+    v.f = value;
+    return fXtocstrCStyle(v.u, str, maxSize, scientific, true, 8, 23);
+}
+
+size_t CLRX::dtocstrShortestCStyle(double value, char* str, size_t maxSize,
+            bool scientific)
+{
+    DoubleUnion v;
+    v.d = value;
+    return fXtocstrCStyle(v.u, str, maxSize, scientific, true, 11, 52);
+}
+
+size_t CLRX::htocstrFixedCStyle(cxushort value, char* str, size_t maxSize,
+            cxuint precision, bool scientific)
+{
+    return fXtocstrFixedCStyle(value, str, maxSize, precision, scientific, 5, 10);
+}
+
+size_t CLRX::ftocstrFixedCStyle(float value, char* str, size_t maxSize,
+            cxuint precision, bool scientific)
+{
+    FloatUnion v;
+    v.f = value;
+    return fXtocstrFixedCStyle(v.u, str, maxSize, precision, scientific, 8, 23);
+}
+
+size_t CLRX::dtocstrFixedCStyle(double value, char* str, size_t maxSize,
+            cxuint precision, bool scientific)
+{
+    DoubleUnion v;
+    v.d = value;
+    return fXtocstrFixedCStyle(v.u, str, maxSize, precision, scientific, 11, 52);
+}
+
+size_t CLRX::htocstrHexCStyle(cxushort value, char* str, size_t maxSize)
+{
+    return fXtocstrHexCStyle(value, str, maxSize, 5, 10);
+}
+
+size_t CLRX::ftocstrHexCStyle(float value, char* str, size_t maxSize)
+{
+    FloatUnion v;
+    v.f = value;
+    return fXtocstrHexCStyle(v.u, str, maxSize, 8, 23);
+}
+
+size_t CLRX::dtocstrHexCStyle(double value, char* str, size_t maxSize)
+{
+    DoubleUnion v;
+    v.d = value;
+    return fXtocstrHexCStyle(v.u, str, maxSize, 11, 52);
+}
+
+size_t CLRX::u32tocstrCStyle(uint32_t value, char* str, size_t maxSize, cxuint radix,
+             cxuint width, bool prefix, cxuint flags)
+{
+    return u64tocstrCStyle(value, str, maxSize, radix, width, prefix, flags);
+}
+
+size_t CLRX::u64tocstrCStyle(uint64_t value, char* str, size_t maxSize, cxuint radix,
+            cxuint width, bool prefix, cxuint flags)
+{
+    cxuint digitsNum = 0;
+    cxuint groupSize = 3;
+    const bool upper = (flags & UXTOCSTR_UPPERCASE) != 0;
+    const cxuint bitsNum = (value != 0) ? 64 - CLZ64(value) : 1;
+
+    char* strend = str + maxSize-1;
+    char* p = str;
+    switch(radix)
+    {
+        case 2:
+            if (prefix)
+            {
+                if (p+2 >= strend)
+                    throw Exception("Max size is too small");
+                *p++ = '0';
+                *p++ = upper ? 'B' : 'b';
+            }
+            digitsNum = bitsNum;
+            groupSize = 4;
+            break;
+        case 8:
+            if (prefix)
+            {
+                if (p+1 >= strend)
+                    throw Exception("Max size is too small");
+                *p++ = '0';
+            }
+            digitsNum = (bitsNum+2)/3;
+            break;
+        case 10:
+            digitsNum = (value != 0) ? u64DecDigitsNum(value) : 1;
+            break;
+        case 16:
+            if (prefix)
+            {
+                if (p+2 >= strend)
+                    throw Exception("Max size is too small");
+                *p++ = '0';
+                *p++ = upper ? 'X' : 'x';
+            }
+            digitsNum = (bitsNum+3)>>2;
+            groupSize = 4;
+            break;
+        default:
+            throw Exception("Unknown radix");
+            break;
+    }
+
+    // non-decimal numbers are filled by zeroes to width
+    const cxuint paddedNum = (radix != 10 && digitsNum < width) ? width : digitsNum;
+    const bool grouping = (flags & UXTOCSTR_GROUP_DIGITS) != 0;
+    const cxuint outNum = (!grouping) ? paddedNum : paddedNum + (paddedNum-1)/groupSize;
+    if (p+outNum > strend || p+width > strend)
+        throw Exception("Max size is too small");
+
+    // decimal numbers are filled by spaces
+    for (cxuint pos = outNum; pos < width; pos++)
+        *p++ = ' ';
+
+    // digits are written directly at their final positions
+    char* digits = p;
+    for (cxuint pos = digitsNum; pos < paddedNum; pos++)
+        *p++ = '0';
+    switch(radix)
+    {
+        case 2:
+            u64WriteBinDigits(value, digitsNum, p);
+            break;
+        case 8:
+            u64WriteOctDigits(value, digitsNum, p);
+            break;
+        case 10:
+#ifdef HAVE_SSE2
+            u64WriteDecDigitsSSE2(value, digitsNum, p);
+#else
+            u64WriteDecDigits(value, digitsNum, p);
+#endif
+            break;
+        default:
+            u64WriteHexDigits(value, digitsNum, p, upper);
+            break;
+    }
+    p = digits + outNum;
+    if (grouping)
+    {   // spread digits from end (in place)
+        const char* src = digits + paddedNum;
+        char* dest = p;
+        for (cxuint pos = 0; src != digits; pos++)
+        {
+            if (pos != 0 && pos % groupSize == 0)
+                *--dest = '_';
+            *--dest = *--src;
+        }
+    }
+
+    *p = 0;
+    return p-str;
+}
+
+/*
+ * big integer to string conversion
+ */
+
+/* numbers not greater than this limbs number are converted by simple division
+ * (divide-and-conquer is faster above this size, measured by benchmark) */
+static const cxuint BIGTOCSTR_DIVCONQ_LIMBS = 128;
+/* decimal digits of small numbers (converted by simple division) are formatted
+ * in stack buffer */
+static const size_t BIGTOCSTR_STACK_DIGITS = 2480;
+/* number of cached powers 10**(19*2**k) (greatest has 32330 limbs, about 2MB) */
+static const cxuint BIGTOCSTR_CACHED_POWERS = 16;
+
+/* write 19 decimal digits (with leading zeroes) of chunk (lower than 10**19) */
+static inline char* u64WriteDecChunk(uint64_t chunk, char* out)
+{
+    std::fill(out, out+19, '0');
+    if (chunk != 0)
+        u64WriteDecDigits(chunk, 19, out);
+    return out+19;
+}
+
+/* simple conversion by repeated division by 10**19.
+ * if padDigits is nonzero then output is padded by zeroes to padDigits */
+static char* bigtocstrDecSimple(cxuint size, const uint64_t* bigNum, size_t padDigits,
+            char* out)
+{
+    uint64_t value[BIGTOCSTR_DIVCONQ_LIMBS];
+    uint64_t chunks[BIGTOCSTR_DIVCONQ_LIMBS+2];
+    std::copy(bigNum, bigNum+size, value);
+    cxuint chunksNum = 0;
+    while (size != 0)
+    {
+        uint64_t rem = 0;
+        for (cxuint i = size; i > 0; i--)
+            value[i-1] = div128By64(rem, value[i-1], power10sTable[19], rem);
+        chunks[chunksNum++] = rem;
+        if (value[size-1] == 0)
+            size--;
+    }
+    if (padDigits != 0)
+    {
+        std::fill(out, out + padDigits - size_t(chunksNum)*19, '0');
+        out += padDigits - size_t(chunksNum)*19;
+    }
+    else if (chunksNum != 0)
+    {   // leading chunk without zeroes
+        const cxuint digitsNum = u64DecDigitsNum(chunks[chunksNum-1]);
+        u64WriteDecDigits(chunks[chunksNum-1], digitsNum, out);
+        out += digitsNum;
+        chunksNum--;
+    }
+    for (cxuint i = chunksNum; i > 0; i--)
+        out = u64WriteDecChunk(chunks[i-1], out);
+    return out;
+}
+
+/* reciprocal of normalized divisor (highest bit is set) for Barrett division:
+ * recip = floor(B**(2*size)/div), where B=2**64 (size+1 limbs).
+ * computed by Newton iteration from reciprocal of higher half */
+static void bigReciprocal(cxuint size, const uint64_t* div, uint64_t* recip)
+{
+    if (size == 1)
+    {
+        if (div[0] == (1ULL<<63))
+        {
+            recip[0] = 0;
+            recip[1] = 2;
+        }
+        else
+        {   // B**2/d = B + (B-d)*B/d
+            uint64_t rem;
+            recip[0] = div128By64(-div[0], 0, div[0], rem);
+            recip[1] = 1;
+        }
+        return;
+    }
+    const cxuint halfSize = (size+1)>>1;
+    // using vector for prevents memory leaks (function can throw exception)
+    std::vector<uint64_t> heap((halfSize+1) + (2*size+2)*2 + (3*size+2));
+    uint64_t* halfRecip = heap.data();
+    uint64_t* prod = halfRecip + halfSize+1; // 2*size+2 limbs
+    uint64_t* error = prod + 2*size+2; // 2*size+2 limbs
+    uint64_t* delta = error + 2*size+2; // 3*size+2 limbs
+    
+    bigReciprocal(halfSize, div + size-halfSize, halfRecip);
+    // first approximation: halfRecip*B**(size-halfSize)
+    std::fill(recip, recip + size-halfSize, uint64_t(0));
+    std::copy(halfRecip, halfRecip + halfSize+1, recip + size-halfSize);
+    
+    // Newton step: recip += recip*(B**(2*size) - div*recip)/B**(2*size)
+    bigMul(size, div, size+1, recip, prod);
+    prod[2*size+1] = 0;
+    std::fill(error, error + 2*size+2, uint64_t(0));
+    error[2*size] = 1;
+    bigSub(2*size+2, error, 2*size+2, prod);
+    const bool negError = (error[2*size+1] >> 63) != 0;
+    if (negError)
+    {   // negate
+        bool carry = true;
+        for (cxuint i = 0; i < 2*size+1; i++)
+        {
+            error[i] = ~error[i] + carry;
+            carry = carry && (error[i] == 0);
+        }
+    }
+    bigMul(size+1, recip, 2*size+1, error, delta);
+    if (negError)
+        bigSub(size+1, recip, size+1, delta + 2*size);
+    else
+        bigAdd(size+1, recip, size+1, delta + 2*size);
+    
+    // final correction: 0 <= B**(2*size) - div*recip < div
+    bigMul(size, div, size+1, recip, prod);
+    prod[2*size+1] = 0;
+    std::fill(error, error + 2*size+2, uint64_t(0));
+    error[2*size] = 1;
+    bigSub(2*size+2, error, 2*size+2, prod);
+    const uint64_t one = 1;
+    while ((error[2*size+1] >> 63) != 0)
+    {
+        bigSub(size+1, recip, 1, &one);
+        bigAdd(2*size+2, error, size, div);
+    }
+    while (std::find_if(error + size, error + 2*size+2,
+                [](uint64_t v) { return v != 0; }) != error + 2*size+2 ||
+           bigUIntCompare(size, error, div) >= 0)
+    {
+        bigAdd(size+1, recip, 1, &one);
+        bigSub(2*size+2, error, size, div);
+    }
+}
+
+/* Barrett division of number (numSize limbs, size < numSize <= 2*size, smaller than
+ * div*B**size) by normalized divisor (size limbs). quotient has numSize-size+1 limbs,
+ * remainder replaces lower size limbs of number. Only higher limbs of reciprocal are
+ * used, hence cost depends on size of quotient. Balanced products are padded by zeroes
+ * to padSize limbs (power of 2, greater than size), because bigMul is fastest for such
+ * sizes (divisor is padded). tmp has 6*padSize limbs */
+static void bigDivBarrett(cxuint numSize, cxuint size, cxuint padSize, uint64_t* num,
+            const uint64_t* div, const uint64_t* recip, uint64_t* quot, uint64_t* tmp)
+{
+    const cxuint quotSize = numSize-size+1;
+    const cxuint quotPadSize = (quotSize > 1) ? 1U << (32-CLZ32(quotSize-1)) : 1;
+    uint64_t* numTop = tmp; // quotPadSize limbs
+    uint64_t* recipTop = numTop + quotPadSize; // quotPadSize limbs
+    uint64_t* prod = recipTop + quotPadSize; // 2*padSize limbs
+    uint64_t* quotPad = prod + 2*padSize; // padSize limbs
+    // estimate: floor(floor(num/B**(size-1))*floor(recip/B**(size+1-quotSize))/
+    // B**quotSize), error is at most 3
+    std::copy(num + size-1, num + numSize, numTop);
+    std::fill(numTop + quotSize, numTop + quotPadSize, uint64_t(0));
+    std::copy(recip + size+1-quotSize, recip + size+1, recipTop);
+    std::fill(recipTop + quotSize, recipTop + quotPadSize, uint64_t(0));
+    bigMulPow2(quotPadSize, numTop, recipTop, prod);
+    std::copy(prod + quotSize, prod + 2*quotSize, quotPad);
+    std::fill(quotPad + quotSize, quotPad + padSize, uint64_t(0));
+    if ((quotSize<<1) > padSize)
+        bigMulPow2(padSize, quotPad, div, prod);
+    else
+        bigMul(quotSize, quotPad, size, div, prod);
+    bigSub(numSize, num, numSize, prod);
+    const uint64_t one = 1;
+    while (std::find_if(num + size, num + numSize,
+                [](uint64_t v) { return v != 0; }) != num + numSize ||
+           bigUIntCompare(size, num, div) >= 0)
+    {
+        bigSub(numSize, num, size, div);
+        bigAdd(quotSize, quotPad, 1, &one);
+    }
+    std::copy(quotPad, quotPad + quotSize, quot);
+}
+
+/* power 10**(19*2**k) with data for Barrett division */
+struct BigDecPower
+{
+    std::vector<uint64_t> value;
+    std::vector<uint64_t> divisor; // value shifted left (highest bit is set), padded
+    std::vector<uint64_t> recip; // reciprocal of divisor
+    cxuint shift;
+    cxuint padSize; // zero if power is not used for splitting
+};
+
+/* compute next power (square of previous power or 10**19 if previous is null) */
+static void bigDecPowerInit(BigDecPower& power, const BigDecPower* prev)
+{
+    if (prev == nullptr)
+        power.value.assign(1, power10sTable[19]);
+    else
+    {
+        const cxuint prevSize = prev->value.size();
+        power.value.resize(prevSize<<1);
+        bigMul(prevSize, prev->value.data(), prevSize, prev->value.data(),
+                    power.value.data());
+        if (power.value.back() == 0)
+            power.value.pop_back();
+    }
+    const cxuint powSize = power.value.size();
+    power.shift = CLZ64(power.value.back());
+    power.padSize = 0;
+    if ((powSize<<1) <= BIGTOCSTR_DIVCONQ_LIMBS)
+        return; // not used for splitting
+    power.padSize = 1U << (32-CLZ32(powSize));
+    power.divisor.assign(power.padSize, 0);
+    std::copy(power.value.begin(), power.value.end(), power.divisor.begin());
+    bigUIntShiftLeft(powSize, power.divisor.data(), power.shift);
+    power.recip.resize(powSize+1);
+    bigReciprocal(powSize, power.divisor.data(), power.recip.data());
+}
+
+/*
+ * cache of powers 10**(19*2**k) for decimal conversion. Powers are filled once
+ * (serialized by mutex) and read lock-free. Greater powers are computed by every call.
+ */
+
+static std::atomic<const BigDecPower*> bigDecPowersCache[BIGTOCSTR_CACHED_POWERS];
+static std::unique_ptr<BigDecPower> bigDecPowersStorage[BIGTOCSTR_CACHED_POWERS];
+static std::mutex bigDecPowersMutex;
+
+/* get powers 10**(19*2**k) for k < levelsNum. uncached powers are stored in
+ * uncached vector */
+static void bigDecPowersGet(cxuint levelsNum, const BigDecPower** powers,
+            std::vector<BigDecPower>& uncached)
+{
+    uncached.reserve(levelsNum);
+    for (cxuint k = 0; k < levelsNum; k++)
+    {
+        if (k >= BIGTOCSTR_CACHED_POWERS)
+        {
+            uncached.emplace_back();
+            bigDecPowerInit(uncached.back(), powers[k-1]);
+            powers[k] = &uncached.back();
+            continue;
+        }
+        powers[k] = bigDecPowersCache[k].load(std::memory_order_acquire);
+        if (powers[k] != nullptr)
+            continue;
+        std::lock_guard<std::mutex> lock(bigDecPowersMutex);
+        for (cxuint i = 0; i <= k; i++)
+            if (bigDecPowersStorage[i] == nullptr)
+            {   // fill and publish new power
+                std::unique_ptr<BigDecPower> power(new BigDecPower);
+                bigDecPowerInit(*power, (i != 0) ? bigDecPowersStorage[i-1].get() :
+                            nullptr);
+                bigDecPowersStorage[i] = std::move(power);
+                bigDecPowersCache[i].store(bigDecPowersStorage[i].get(),
+                            std::memory_order_release);
+            }
+        powers[k] = bigDecPowersStorage[k].get();
+    }
+}
+
+/* divide-and-conquer decimal conversion: number (smaller than 10**(19*2**level)) is
+ * split by 10**(19*2**(level-1)). if not leading then output is padded by zeroes
+ * to 19*2**level digits. scratch is shared by all levels of recursion */
+static char* bigtocstrDecimal(cxuint size, const uint64_t* bigNum, cxuint level,
+            bool leading, const BigDecPower* const* powers, uint64_t* scratch, char* out)
+{
+    while (size != 0 && bigNum[size-1] == 0)
+        size--;
+    if (level == 0 || size <= BIGTOCSTR_DIVCONQ_LIMBS)
+        return bigtocstrDecSimple(size, bigNum, leading ? 0 : size_t(19)<<level, out);
+    
+    const BigDecPower& power = *powers[level-1];
+    const cxuint powSize = power.value.size();
+    if (size < powSize)
+    {   // number is smaller than power, quotient is zero
+        if (!leading)
+        {
+            std::fill(out, out + (size_t(19)<<(level-1)), '0');
+            out += size_t(19)<<(level-1);
+        }
+        return bigtocstrDecimal(size, bigNum, level-1, leading, powers, scratch, out);
+    }
+    // shifted number has at most 2*powSize limbs, because it is smaller than div*power
+    const cxuint numSize = std::min(size+1, 2*powSize);
+    const cxuint quotSize = numSize-powSize+1;
+    uint64_t* num = scratch; // remainder after division
+    uint64_t* quot = num + numSize;
+    std::copy(bigNum, bigNum+size, num);
+    if (numSize > size)
+        num[numSize-1] = 0;
+    bigUIntShiftLeft(numSize, num, power.shift);
+    bigDivBarrett(numSize, powSize, power.padSize, num, power.divisor.data(),
+                power.recip.data(), quot, quot + quotSize);
+    bigUIntShiftRight(powSize, num, power.shift);
     
-    cxuint oneBitPos = mantisaShift - (binExpOfValue-reqBinExpOfValue);
+    if (!leading || std::find_if(quot, quot + quotSize,
+                [](uint64_t v) { return v != 0; }) != quot + quotSize)
+    {
+        out = bigtocstrDecimal(quotSize, quot, level-1, leading, powers,
+                    quot + quotSize, out);
+        leading = false;
+    }
+    return bigtocstrDecimal(powSize, num, level-1, leading, powers, quot + quotSize, out);
+}
+
+size_t CLRX::bigtocstrCStyle(cxuint size, const uint64_t* bigNum, char* str,
+            size_t maxSize, cxuint radix, cxuint width, bool prefix)
+{
+    while (size != 0 && bigNum[size-1] == 0)
+        size--;
+    if (size <= 1) // single 64-bit value
+        return u64tocstrCStyle((size != 0) ? bigNum[0] : 0, str, maxSize, radix,
+                    width, prefix);
     
-    uint64_t pow5[2];
-    uint64_t rescaled[4];
-    cxuint powSize;
-    cxint pow5Exp;
-    // generate rescaled value
-    if (decExpOfValue != 0)
+    const size_t bitsNum = (size_t(size)<<6) - CLZ64(bigNum[size-1]);
+    char* strend = str + maxSize-1;
+    char* p = str;
+    if (radix == 2 || radix == 8 || radix == 16)
     {
-        const uint64_t inMantisa[2] = { 0, mantisa };
-        bigPow5(-decExpOfValue, 2, powSize, pow5Exp, pow5);
-        bigMul(powSize, pow5, 2, inMantisa, rescaled);
-        rescaled[powSize+1] += mantisa;
-        oneBitPos++;
+        if (prefix)
+        {
+            if (p + ((radix != 8) ? 2 : 1) >= strend)
+                throw Exception("Max size is too small");
+            *p++ = '0';
+            if (radix != 8)
+                *p++ = (radix == 2) ? 'b' : 'x';
+        }
+        const cxuint digitBits = (radix == 2) ? 1 : (radix == 8) ? 3 : 4;
+        const size_t digitsNum = (bitsNum + digitBits-1) / digitBits;
+        if (p+digitsNum > strend || p+width > strend)
+            throw Exception("Max size is too small");
+        for (size_t pos = digitsNum; pos < width; pos++)
+            *p++ = '0';
+        // direct extraction of digits (from most significant)
+        for (size_t pos = digitsNum; pos > 0; pos--)
+        {
+            const size_t bitPos = (pos-1)*digitBits;
+            const cxuint limb = bitPos>>6;
+            const cxuint bitShift = bitPos&63;
+            uint64_t bits = bigNum[limb] >> bitShift;
+            if (bitShift + digitBits > 64 && limb+1 < size)
+                bits |= bigNum[limb+1] << (64-bitShift);
+            const cxuint digit = bits & ((1U<<digitBits)-1);
+            *p++ = (digit < 10) ? ('0'+digit) : ('a'+digit-10);
+        }
+        *p = 0;
+        return p-str;
+    }
+    else if (radix != 10)
+        throw Exception("Unknown radix");
+    
+    // digits number is not greater than bitsNum*log10(2)+1
+    const size_t maxDigitsNum = bitsNum*30103/100000 + 2;
+    // small numbers are formatted in stack buffer
+    char stackBuffer[BIGTOCSTR_STACK_DIGITS];
+    // using vector for prevents memory leaks (function can throw exception)
+    std::vector<char> heapBuffer;
+    char* buffer = stackBuffer;
+    if (maxDigitsNum > BIGTOCSTR_STACK_DIGITS)
+    {
+        heapBuffer.resize(maxDigitsNum);
+        buffer = heapBuffer.data();
     }
+    char* bufEnd;
+    if (size <= BIGTOCSTR_DIVCONQ_LIMBS)
+        bufEnd = bigtocstrDecSimple(size, bigNum, 0, buffer);
     else
-    {   /* if one */
-        powSize = 1;
-        pow5[0] = 0;
-        rescaled[0] = rescaled[1] = 0;
-        rescaled[2] = mantisa;
+    {   // number is smaller than 10**(19*2**levelsNum)
+        cxuint levelsNum = 0;
+        while ((size_t(19)<<levelsNum) < maxDigitsNum)
+            levelsNum++;
+        // using vector for prevents memory leaks (function can throw exception)
+        std::vector<const BigDecPower*> powers(levelsNum);
+        std::vector<BigDecPower> uncached;
+        bigDecPowersGet(levelsNum, powers.data(), uncached);
+        // scratch for all levels (3*powSize+1 at every level and Barrett division)
+        size_t scratchSize = 0;
+        for (cxuint k = 0; k < levelsNum; k++)
+            if (powers[k]->padSize != 0)
+                scratchSize = 3*powers[k]->value.size()+1 +
+                        std::max(scratchSize, size_t(powers[k]->padSize)*6);
+        std::vector<uint64_t> scratch(scratchSize);
+        bufEnd = bigtocstrDecimal(size, bigNum, levelsNum, true, powers.data(),
+                    scratch.data(), buffer);
     }
     
-    const uint64_t oneValue = 1ULL<<oneBitPos;
-    uint64_t decValue = rescaled[powSize+1]>>oneBitPos;
-    char buffer[20];
-    cxuint digitsNum = 0;
+    const size_t digitsNum = bufEnd - buffer;
+    if (p+digitsNum > strend || p+width > strend)
+        throw Exception("Max size is too small");
+    for (size_t pos = digitsNum; pos < width; pos++)
+        *p++ = ' ';
+    std::copy(buffer, bufEnd, p);
+    p += digitsNum;
+    *p = 0;
+    return p-str;
+}
+
+/* write decimal digits of 128-bit value (not lower than 2**64), returns end of digits.
+ * value = (top*10**19 + mid)*10**19 + low, top is nonzero only for 39-digit values */
+static char* u128WriteDecDigits(const uint64_t* value, char* out)
+{
+    const uint64_t pow19 = power10sTable[19];
+    const uint64_t hiQuot = value[1] / pow19;
+    uint64_t low, mid;
+    const uint64_t loQuot = div128By64(value[1] - hiQuot*pow19, value[0], pow19, low);
+    uint64_t top = 0;
+    if (hiQuot != 0)
+        top = div128By64(hiQuot, loQuot, pow19, mid);
+    else
+        mid = loQuot;
+    if (top != 0)
+    {
+        const cxuint digitsNum = u64DecDigitsNum(top);
+        u64WriteDecDigits(top, digitsNum, out);
+        out = u64WriteDecChunk(mid, out + digitsNum);
+    }
+    else
+    {   // mid is nonzero, because value is not lower than 2**64
+        const cxuint digitsNum = u64DecDigitsNum(mid);
+        u64WriteDecDigits(mid, digitsNum, out);
+        out += digitsNum;
+    }
+    return u64WriteDecChunk(low, out);
+}
+
+size_t CLRX::u128tocstrCStyle(const uint64_t* value, char* str, size_t maxSize,
+            cxuint radix, cxuint width, bool prefix)
+{
+    if (radix != 10 || value[1] == 0)
+        // 64-bit values and digits in radix 2, 8, 16 are formatted without allocation
+        return bigtocstrCStyle(2, value, str, maxSize, radix, width, prefix);
     
-    bool roundingFix = false;
-    /* fix for rounding to ten */
-    const cxuint mod = (decValue) % 100;
-    /* check rounding digits */
-    if (mod >= 82 || (mod <= 18 && mod != 0))
-    {   // check higher round
-        uint64_t rescaledHalf[4];
-        // rescaled half (ULP) minus rescaled max error + 1
-        rescaledHalf[0] = 0;
-        rescaledHalf[1] = pow5[0]<<(mantisaShift-1);
-        rescaledHalf[2] = pow5[0]>>(64-mantisaShift+1);
-        if (powSize == 2)
+    /* decimal digits are emitted in 19-digit chunks (128/64-bit division) */
+    char buffer[40];
+    const size_t digitsNum = u128WriteDecDigits(value, buffer) - buffer;
+    char* p = str;
+    char* strend = str + maxSize-1;
+    if (p+digitsNum > strend || p+width > strend)
+        throw Exception("Max size is too small");
+    for (size_t pos = digitsNum; pos < width; pos++)
+        *p++ = ' ';
+    ::memcpy(p, buffer, digitsNum);
+    p += digitsNum;
+    *p = 0;
+    return p-str;
+}
+
+/*
+ * non-throwing formatting (size query)
+ */
+
+/* length of u64tocstrCStyle output (or zero if radix is unknown) */
+static size_t u64tocstrLength(uint64_t value, cxuint radix, cxuint width, bool prefix,
+            cxuint flags)
+{
+    const cxuint bitsNum = (value != 0) ? 64 - CLZ64(value) : 1;
+    cxuint digitsNum = 0;
+    size_t prefixNum = 0;
+    switch(radix)
+    {
+        case 2:
+            digitsNum = bitsNum;
+            prefixNum = 2;
+            break;
+        case 8:
+            digitsNum = (bitsNum+2)/3;
+            prefixNum = 1;
+            break;
+        case 10:
+            digitsNum = (value != 0) ? u64DecDigitsNum(value) : 1;
+            break;
+        case 16:
+            digitsNum = (bitsNum+3)>>2;
+            prefixNum = 2;
+            break;
+        default:
+            return 0;
+    }
+    if (!prefix)
+        prefixNum = 0;
+    const cxuint paddedNum = (radix != 10 && digitsNum < width) ? width : digitsNum;
+    const size_t outNum = uXtocstrGroupedLength(paddedNum, radix, flags);
+    return prefixNum + std::max(outNum, size_t(width));
+}
+
+/* copy formatted output (in buffer) to str if it fits */
+static inline size_t copyNoThrowOutput(const char* buffer, size_t length, char* str,
+            size_t maxSize)
+{
+    if (length < maxSize)
+        ::memcpy(str, buffer, length+1);
+    else if (maxSize != 0)
+        *str = 0;
+    return length;
+}
+
+size_t CLRX::u32tocstrNoThrowCStyle(uint32_t value, char* str, size_t maxSize,
+            cxuint radix, cxuint width, bool prefix, cxuint flags) noexcept
+{
+    return u64tocstrNoThrowCStyle(value, str, maxSize, radix, width, prefix, flags);
+}
+
+size_t CLRX::u64tocstrNoThrowCStyle(uint64_t value, char* str, size_t maxSize,
+            cxuint radix, cxuint width, bool prefix, cxuint flags) noexcept
+{
+    const size_t length = u64tocstrLength(value, radix, width, prefix, flags);
+    if (length == 0 || length >= maxSize)
+    {   // unknown radix or output does not fit
+        if (maxSize != 0)
+            *str = 0;
+        return length;
+    }
+    return u64tocstrCStyle(value, str, maxSize, radix, width, prefix, flags);
+}
+
+size_t CLRX::u128tocstrNoThrowCStyle(const uint64_t* value, char* str, size_t maxSize,
+            cxuint radix, cxuint width, bool prefix) noexcept
+{
+    if (radix != 2 && radix != 8 && radix != 10 && radix != 16)
+    {
+        if (maxSize != 0)
+            *str = 0;
+        return 0;
+    }
+    /* u128tocstrCStyle does not allocate and output always fits (checked below),
+     * so it can not throw here */
+    // length without width filling (prefix and digits)
+    char buffer[u128tocstrMaxLength(2)+1];
+    const size_t prefixNum = (!prefix || radix == 10) ? 0 : (radix == 8) ? 1 : 2;
+    const size_t digitsNum = u128tocstrCStyle(value, buffer, sizeof(buffer), radix, 0,
+                prefix) - prefixNum;
+    const size_t length = (radix == 10) ? std::max(digitsNum, size_t(width)) :
+                prefixNum + std::max(digitsNum, size_t(width));
+    if (width == 0)
+        return copyNoThrowOutput(buffer, length, str, maxSize);
+    if (length >= maxSize)
+    {
+        if (maxSize != 0)
+            *str = 0;
+        return length;
+    }
+    return u128tocstrCStyle(value, str, maxSize, radix, width, prefix);
+}
+
+size_t CLRX::htocstrNoThrowCStyle(cxushort value, char* str, size_t maxSize,
+            bool scientific, bool shortest) noexcept
+{
+    if (maxSize > HTOCSTR_MAX_LENGTH) // always fits
+        return (shortest) ? htocstrShortestCStyle(value, str, maxSize, scientific) :
+                htocstrCStyle(value, str, maxSize, scientific);
+    char buffer[HTOCSTR_MAX_LENGTH+1];
+    const size_t length = (shortest) ?
+            htocstrShortestCStyle(value, buffer, sizeof(buffer), scientific) :
+            htocstrCStyle(value, buffer, sizeof(buffer), scientific);
+    return copyNoThrowOutput(buffer, length, str, maxSize);
+}
+
+size_t CLRX::ftocstrNoThrowCStyle(float value, char* str, size_t maxSize,
+            bool scientific, bool shortest) noexcept
+{
+    if (maxSize > FTOCSTR_MAX_LENGTH) // always fits
+        return (shortest) ? ftocstrShortestCStyle(value, str, maxSize, scientific) :
+                ftocstrCStyle(value, str, maxSize, scientific);
+    char buffer[FTOCSTR_MAX_LENGTH+1];
+    const size_t length = (shortest) ?
+            ftocstrShortestCStyle(value, buffer, sizeof(buffer), scientific) :
+            ftocstrCStyle(value, buffer, sizeof(buffer), scientific);
+    return copyNoThrowOutput(buffer, length, str, maxSize);
+}
+
+size_t CLRX::dtocstrNoThrowCStyle(double value, char* str, size_t maxSize,
+            bool scientific, bool shortest) noexcept
+{
+    if (maxSize > DTOCSTR_MAX_LENGTH) // always fits
+        return (shortest) ? dtocstrShortestCStyle(value, str, maxSize, scientific) :
+                dtocstrCStyle(value, str, maxSize, scientific);
+    char buffer[DTOCSTR_MAX_LENGTH+1];
+    const size_t length = (shortest) ?
+            dtocstrShortestCStyle(value, buffer, sizeof(buffer), scientific) :
+            dtocstrCStyle(value, buffer, sizeof(buffer), scientific);
+    return copyNoThrowOutput(buffer, length, str, maxSize);
+}
+
+size_t CLRX::htocstrHexNoThrowCStyle(cxushort value, char* str, size_t maxSize) noexcept
+{
+    if (maxSize > HTOCSTR_HEX_MAX_LENGTH) // always fits
+        return fXtocstrHexCStyle(value, str, maxSize, 5, 10);
+    char buffer[HTOCSTR_HEX_MAX_LENGTH+1];
+    const size_t length = fXtocstrHexCStyle(value, buffer, sizeof(buffer), 5, 10);
+    return copyNoThrowOutput(buffer, length, str, maxSize);
+}
+
+size_t CLRX::ftocstrHexNoThrowCStyle(float value, char* str, size_t maxSize) noexcept
+{
+    FloatUnion v;
+    v.f = value;
+    if (maxSize > FTOCSTR_HEX_MAX_LENGTH) // always fits
+        return fXtocstrHexCStyle(v.u, str, maxSize, 8, 23);
+    char buffer[FTOCSTR_HEX_MAX_LENGTH+1];
+    const size_t length = fXtocstrHexCStyle(v.u, buffer, sizeof(buffer), 8, 23);
+    return copyNoThrowOutput(buffer, length, str, maxSize);
+}
+
+size_t CLRX::dtocstrHexNoThrowCStyle(double value, char* str, size_t maxSize) noexcept
+{
+    DoubleUnion v;
+    v.d = value;
+    if (maxSize > DTOCSTR_HEX_MAX_LENGTH) // always fits
+        return fXtocstrHexCStyle(v.u, str, maxSize, 11, 52);
+    char buffer[DTOCSTR_HEX_MAX_LENGTH+1];
+    const size_t length = fXtocstrHexCStyle(v.u, buffer, sizeof(buffer), 11, 52);
+    return copyNoThrowOutput(buffer, length, str, maxSize);
+}
+
+/* no float value has more than 18 leading nines in decimal expansion, hence rounding
+ * with this or higher precision never carries to next power of 10 and length of
+ * output grows by one with every next digit of precision */
+static const cxuint FXTOCSTR_MEASURE_PRECISION = 40;
+/* buffer for output measured with FXTOCSTR_MEASURE_PRECISION or exact precision */
+static const size_t FXTOCSTR_MEASURE_BUFFER_SIZE =
+        ((dtocstrFixedMaxLength(FXTOCSTR_MEASURE_PRECISION) >
+          dtocstrFixedMaxLength(FXTOCSTR_EXACT_PRECISION)) ?
+          dtocstrFixedMaxLength(FXTOCSTR_MEASURE_PRECISION) :
+          dtocstrFixedMaxLength(FXTOCSTR_EXACT_PRECISION)) + 1;
+
+static size_t fXtocstrFixedNoThrow(uint64_t value, char* str, size_t maxSize,
+        cxuint precision, bool scientific, cxuint expBits, cxuint mantisaBits,
+        size_t maxLength) noexcept
+{
+    try
+    {
+        if (maxSize > maxLength) // always fits
+            return fXtocstrFixedCStyle(value, str, maxSize, precision, scientific,
+                        expBits, mantisaBits);
+        // measure output with limited precision (only few digits are formatted)
+        const cxuint measurePrecision = (precision != FXTOCSTR_EXACT_PRECISION) ?
+                std::min(precision, FXTOCSTR_MEASURE_PRECISION) : precision;
+        char buffer[FXTOCSTR_MEASURE_BUFFER_SIZE];
+        const size_t length = fXtocstrFixedCStyle(value, buffer, sizeof(buffer),
+                    measurePrecision, scientific, expBits, mantisaBits) +
+                    (precision - measurePrecision);
+        if (precision == measurePrecision || length >= maxSize)
+            return copyNoThrowOutput(buffer, length, str, maxSize);
+        return fXtocstrFixedCStyle(value, str, maxSize, precision, scientific,
+                    expBits, mantisaBits);
+    }
+    catch(const std::bad_alloc& ex)
+    {
+        if (maxSize != 0)
+            *str = 0;
+        return 0;
+    }
+}
+
+size_t CLRX::htocstrFixedNoThrowCStyle(cxushort value, char* str, size_t maxSize,
+            cxuint precision, bool scientific) noexcept
+{
+    return fXtocstrFixedNoThrow(value, str, maxSize, precision, scientific, 5, 10,
+                htocstrFixedMaxLength(precision, scientific));
+}
+
+size_t CLRX::ftocstrFixedNoThrowCStyle(float value, char* str, size_t maxSize,
+            cxuint precision, bool scientific) noexcept
+{
+    FloatUnion v;
+    v.f = value;
+    return fXtocstrFixedNoThrow(v.u, str, maxSize, precision, scientific, 8, 23,
+                ftocstrFixedMaxLength(precision, scientific));
+}
+
+size_t CLRX::dtocstrFixedNoThrowCStyle(double value, char* str, size_t maxSize,
+            cxuint precision, bool scientific) noexcept
+{
+    DoubleUnion v;
+    v.d = value;
+    return fXtocstrFixedNoThrow(v.u, str, maxSize, precision, scientific, 11, 52,
+                dtocstrFixedMaxLength(precision, scientific));
+}
+
+/*
+ * batch formatting of arrays
+ */
+
+/* format n elements separated by separator to str. formatElem(i, out, outMaxSize)
+ * formats element i and returns its length (throws exception if it does not fit) */
+template<typename FormatElem>
+static size_t formatArrayCStyle(size_t n, char* str, size_t maxSize, char separator,
+            size_t* offsets, FormatElem formatElem)
+{
+    if (maxSize == 0)
+        throw Exception("Max size is too small");
+    char* p = str;
+    const char* strend = str + maxSize-1;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (i != 0)
         {
-            rescaledHalf[2] |= pow5[1]<<(mantisaShift-1);
-            rescaledHalf[3] = pow5[1]>>(64-mantisaShift+1);
-        }
-        rescaledHalf[powSize+1] |= (1ULL<<(mantisaShift-1));
-        
-        if (-decExpOfValue < 0 || -decExpOfValue > 55)
-        {   // if not exact pow5 (rescaled value is not exact value)
-            // compute max error of rescaled value ((0.5 + 2**-29)*mantisa)
-            const uint64_t maxRescaledError[2] = 
-            { mantisa<<(64-30), (mantisa>>1) + (mantisa>>30) };
-            bigSub(powSize+2, rescaledHalf, 2, maxRescaledError);
+            if (p >= strend)
+                throw Exception("Max size is too small");
+            *p++ = separator;
         }
-        const uint64_t one64 = 1; // preserve rounding for exact half case
-        bigSub(powSize+2, rescaledHalf, 1, &one64);
-        
-        if (mod >= 82)
-        {   // we must add some bits
-            uint64_t toAdd[4] = { 0, 0, 0, 0 };
-            // (100-mod) - (rest from value beginning one) - value to add
-            toAdd[powSize+1] = ((100ULL-uint64_t(mod))<<oneBitPos) +
-                    (rescaled[powSize+1] & ~(oneValue-1));
-            bigSub(2+powSize, toAdd, 2+powSize, rescaled);
-            // check if half changed
-            if (!bigSub(2+powSize, rescaledHalf, 2+powSize, toAdd))
-            {   // if toAdd is smaller than rescaledHalf
-                decValue += (100-mod);
-                roundingFix = true;
-            }
+        if (offsets != nullptr)
+            offsets[i] = p-str;
+        p += formatElem(i, p, strend-p+1);
+    }
+    *p = 0;
+    return p-str;
+}
+
+size_t CLRX::u32tocstrArrayCStyle(size_t n, const uint32_t* values, char* str,
+            size_t maxSize, char separator, size_t* offsets, cxuint radix, cxuint width,
+            bool prefix, cxuint flags)
+{
+    if (radix == 10 && width == 0 && flags == 0)
+        // fast path: only digits
+        return formatArrayCStyle(n, str, maxSize, separator, offsets,
+            [values](size_t i, char* out, size_t outMaxSize)
+            {
+                const uint32_t value = values[i];
+                const cxuint digitsNum = (value != 0) ? u64DecDigitsNum(value) : 1;
+                if (digitsNum >= outMaxSize)
+                    throw Exception("Max size is too small");
+                u64WriteDecDigits(value, digitsNum, out);
+                return size_t(digitsNum);
+            });
+    return formatArrayCStyle(n, str, maxSize, separator, offsets,
+        [=](size_t i, char* out, size_t outMaxSize)
+        { return u64tocstrCStyle(values[i], out, outMaxSize, radix, width, prefix, flags); });
+}
+
+size_t CLRX::u64tocstrArrayCStyle(size_t n, const uint64_t* values, char* str,
+            size_t maxSize, char separator, size_t* offsets, cxuint radix, cxuint width,
+            bool prefix, cxuint flags)
+{
+    if (radix == 10 && width == 0 && flags == 0)
+        // fast path: only digits
+        return formatArrayCStyle(n, str, maxSize, separator, offsets,
+            [values](size_t i, char* out, size_t outMaxSize)
+            {
+                const uint64_t value = values[i];
+                const cxuint digitsNum = (value != 0) ? u64DecDigitsNum(value) : 1;
+                if (digitsNum >= outMaxSize)
+                    throw Exception("Max size is too small");
+#ifdef HAVE_SSE2
+                u64WriteDecDigitsSSE2(value, digitsNum, out);
+#else
+                u64WriteDecDigits(value, digitsNum, out);
+#endif
+                return size_t(digitsNum);
+            });
+    return formatArrayCStyle(n, str, maxSize, separator, offsets,
+        [=](size_t i, char* out, size_t outMaxSize)
+        { return u64tocstrCStyle(values[i], out, outMaxSize, radix, width, prefix, flags); });
+}
+
+size_t CLRX::htocstrArrayCStyle(size_t n, const cxushort* values, char* str,
+            size_t maxSize, char separator, size_t* offsets, bool scientific, bool shortest)
+{
+    if (!shortest)
+        return formatArrayCStyle(n, str, maxSize, separator, offsets,
+            [=](size_t i, char* out, size_t outMaxSize)
+            { return htocstrCStyle(values[i], out, outMaxSize, scientific); });
+    return formatArrayCStyle(n, str, maxSize, separator, offsets,
+        [=](size_t i, char* out, size_t outMaxSize)
+        { return fXtocstrCStyle(values[i], out, outMaxSize, scientific, true, 5, 10); });
+}
+
+size_t CLRX::ftocstrArrayCStyle(size_t n, const float* values, char* str,
+            size_t maxSize, char separator, size_t* offsets, bool scientific, bool shortest)
+{
+    return formatArrayCStyle(n, str, maxSize, separator, offsets,
+        [=](size_t i, char* out, size_t outMaxSize)
+        {
+            FloatUnion v;
+            v.f = values[i];
+            return fXtocstrCStyle(v.u, out, outMaxSize, scientific, shortest, 8, 23);
+        });
+}
+
+size_t CLRX::dtocstrArrayCStyle(size_t n, const double* values, char* str,
+            size_t maxSize, char separator, size_t* offsets, bool scientific, bool shortest)
+{
+    return formatArrayCStyle(n, str, maxSize, separator, offsets,
+        [=](size_t i, char* out, size_t outMaxSize)
+        {
+            DoubleUnion v;
+            v.d = values[i];
+            return fXtocstrCStyle(v.u, out, outMaxSize, scientific, shortest, 11, 52);
+        });
+}
+
+/*
+ * parallel batch formatting of arrays (two passes: lengths of chunks, prefix sum
+ * and formatting in place)
+ */
+
+/* minimal number of elements in chunk of parallel formatting */
+static const size_t PARALLEL_ARRAY_MIN_CHUNK = 4096;
+
+static cxuint parallelThreadsNum(cxuint threadsNum)
+{
+    if (threadsNum == 0)
+        threadsNum = std::max(1U, std::thread::hardware_concurrency());
+    return threadsNum;
+}
+
+/* run worker(threadId) on threadsNum threads (current thread is used too).
+ * rethrows first exception thrown by workers */
+template<typename Worker>
+static void runParallel(cxuint threadsNum, Worker worker)
+{
+    std::vector<std::exception_ptr> errors(threadsNum);
+    auto threadBody = [&errors, &worker](cxuint threadId)
+    {
+        try
+        { worker(threadId); }
+        catch(...)
+        { errors[threadId] = std::current_exception(); }
+    };
+    std::vector<std::thread> threads;
+    try
+    {
+        for (cxuint i = 1; i < threadsNum; i++)
+            threads.push_back(std::thread(threadBody, i));
+    }
+    catch(...)
+    {   // cant create thread
+        for (std::thread& thread: threads)
+            thread.join();
+        throw;
+    }
+    threadBody(0);
+    for (std::thread& thread: threads)
+        thread.join();
+    for (const std::exception_ptr& error: errors)
+        if (error)
+            std::rethrow_exception(error);
+}
+
+/* parallel version of formatArrayCStyle. measureElem(i) returns length of element i.
+ * output and offsets do not change if output does not fit (exception is thrown before
+ * writing) */
+template<typename MeasureElem, typename FormatElem>
+static size_t formatArrayParallelCStyle(size_t n, char* str, size_t maxSize,
+        char separator, size_t* offsets, cxuint threadsNum, MeasureElem measureElem,
+        FormatElem formatElem)
+{
+    threadsNum = parallelThreadsNum(threadsNum);
+    if (threadsNum == 1 || n < 2*PARALLEL_ARRAY_MIN_CHUNK)
+        return formatArrayCStyle(n, str, maxSize, separator, offsets, formatElem);
+    
+    // many chunks per thread for balancing load
+    const size_t chunkSize = std::max(PARALLEL_ARRAY_MIN_CHUNK, n / (size_t(threadsNum)*8));
+    const size_t chunksNum = (n + chunkSize-1) / chunkSize;
+    threadsNum = std::min(size_t(threadsNum), chunksNum);
+    // using vector for prevents memory leaks (function can throw exception)
+    std::vector<size_t> chunkOffsets(chunksNum+1);
+    std::atomic<size_t> nextChunk(0);
+    // pass 1: lengths of chunks (every element with separator)
+    runParallel(threadsNum, [&](cxuint)
+    {
+        for (size_t chunk; (chunk = nextChunk.fetch_add(1)) < chunksNum;)
+        {
+            const size_t end = std::min(n, (chunk+1)*chunkSize);
+            size_t length = end - chunk*chunkSize;
+            for (size_t i = chunk*chunkSize; i < end; i++)
+                length += measureElem(i);
+            chunkOffsets[chunk+1] = length;
         }
-        else if (mod <= 18)
-        {   // we must subtract some bits
-            uint64_t toSub[4];
-            // value to subtract
-            toSub[powSize+1] = (uint64_t(mod)<<oneBitPos) |
-                    (rescaled[powSize+1]&(oneValue-1));
-            toSub[0] = rescaled[0];
-            if (powSize == 2)
-                toSub[1] = rescaled[1];
-            toSub[powSize] = rescaled[powSize];
-            // check if half changed
-            if (!bigSub(2+powSize, rescaledHalf, 2+powSize, toSub))
-            {   // if toSub is smaller than rescaledHalf
-                decValue -= mod;
-                roundingFix = true;
+    });
+    for (size_t chunk = 0; chunk < chunksNum; chunk++)
+        chunkOffsets[chunk+1] += chunkOffsets[chunk];
+    const size_t length = chunkOffsets[chunksNum]-1; // without last separator
+    if (length >= maxSize)
+        throw Exception("Max size is too small");
+    
+    // pass 2: format chunks at their offsets. null-character after element is
+    // always overwritten by separator from same chunk
+    nextChunk.store(0);
+    char* strend = str + length+1;
+    runParallel(threadsNum, [&](cxuint)
+    {
+        for (size_t chunk; (chunk = nextChunk.fetch_add(1)) < chunksNum;)
+        {
+            const size_t end = std::min(n, (chunk+1)*chunkSize);
+            char* p = str + chunkOffsets[chunk];
+            for (size_t i = chunk*chunkSize; i < end; i++)
+            {
+                if (offsets != nullptr)
+                    offsets[i] = p-str;
+                p += formatElem(i, p, strend-p);
+                if (i+1 < n)
+                    *p++ = separator;
             }
         }
+    });
+    str[length] = 0;
+    return length;
+}
+
+/* parallel version of formatArrayCStyle for floating point elements. elements are
+ * measured by formatting to small stack buffer (element has at most MaxElemLength
+ * chars), hence scratch does not depend on size of array */
+template<size_t MaxElemLength, typename FormatElem>
+static size_t formatFloatArrayParallelCStyle(size_t n, char* str, size_t maxSize,
+        char separator, size_t* offsets, cxuint threadsNum, FormatElem formatElem)
+{
+    return formatArrayParallelCStyle(n, str, maxSize, separator, offsets, threadsNum,
+        [&formatElem](size_t i)
+        {
+            char buffer[MaxElemLength+1];
+            return formatElem(i, buffer, MaxElemLength+1);
+        }, formatElem);
+}
+
+size_t CLRX::u32tocstrArrayParallelCStyle(size_t n, const uint32_t* values, char* str,
+            size_t maxSize, char separator, size_t* offsets, cxuint radix, cxuint width,
+            bool prefix, cxuint flags, cxuint threadsNum)
+{
+    if (u64tocstrLength(0, radix, width, prefix, flags) == 0)
+        throw Exception("Unknown radix");
+    return formatArrayParallelCStyle(n, str, maxSize, separator, offsets, threadsNum,
+        [=](size_t i)
+        { return u64tocstrLength(values[i], radix, width, prefix, flags); },
+        [=](size_t i, char* out, size_t outMaxSize)
+        { return u64tocstrCStyle(values[i], out, outMaxSize, radix, width, prefix, flags); });
+}
+
+size_t CLRX::u64tocstrArrayParallelCStyle(size_t n, const uint64_t* values, char* str,
+            size_t maxSize, char separator, size_t* offsets, cxuint radix, cxuint width,
+            bool prefix, cxuint flags, cxuint threadsNum)
+{
+    if (u64tocstrLength(0, radix, width, prefix, flags) == 0)
+        throw Exception("Unknown radix");
+    return formatArrayParallelCStyle(n, str, maxSize, separator, offsets, threadsNum,
+        [=](size_t i)
+        { return u64tocstrLength(values[i], radix, width, prefix, flags); },
+        [=](size_t i, char* out, size_t outMaxSize)
+        { return u64tocstrCStyle(values[i], out, outMaxSize, radix, width, prefix, flags); });
+}
+
+size_t CLRX::htocstrArrayParallelCStyle(size_t n, const cxushort* values, char* str,
+            size_t maxSize, char separator, size_t* offsets, bool scientific, bool shortest,
+            cxuint threadsNum)
+{
+    auto formatElem = [=](size_t i, char* out, size_t outMaxSize)
+    {
+        return (!shortest) ? htocstrCStyle(values[i], out, outMaxSize, scientific) :
+                fXtocstrCStyle(values[i], out, outMaxSize, scientific, true, 5, 10);
+    };
+    return formatFloatArrayParallelCStyle<HTOCSTR_MAX_LENGTH>(n, str, maxSize, separator,
+                offsets, threadsNum, formatElem);
+}
+
+size_t CLRX::ftocstrArrayParallelCStyle(size_t n, const float* values, char* str,
+            size_t maxSize, char separator, size_t* offsets, bool scientific, bool shortest,
+            cxuint threadsNum)
+{
+    auto formatElem = [=](size_t i, char* out, size_t outMaxSize)
+    {
+        FloatUnion v;
+        v.f = values[i];
+        return fXtocstrCStyle(v.u, out, outMaxSize, scientific, shortest, 8, 23);
+    };
+    return formatFloatArrayParallelCStyle<FTOCSTR_MAX_LENGTH>(n, str, maxSize, separator,
+                offsets, threadsNum, formatElem);
+}
+
+size_t CLRX::dtocstrArrayParallelCStyle(size_t n, const double* values, char* str,
+            size_t maxSize, char separator, size_t* offsets, bool scientific, bool shortest,
+            cxuint threadsNum)
+{
+    auto formatElem = [=](size_t i, char* out, size_t outMaxSize)
+    {
+        DoubleUnion v;
+        v.d = values[i];
+        return fXtocstrCStyle(v.u, out, outMaxSize, scientific, shortest, 11, 52);
+    };
+    return formatFloatArrayParallelCStyle<DTOCSTR_MAX_LENGTH>(n, str, maxSize, separator,
+                offsets, threadsNum, formatElem);
+}
+
+/*
+ * thread pool with work stealing
+ */
+
+ThreadPool::ThreadPool(cxuint _threadsNum) : threadsNum(parallelThreadsNum(_threadsNum)),
+        workers(new Worker[threadsNum]), task(nullptr), generation(0), runningThreads(0),
+        stopping(false), failed(false)
+{
+    try
+    {
+        for (cxuint i = 1; i < threadsNum; i++)
+            threads.push_back(std::thread(&ThreadPool::threadMain, this, i));
+    }
+    catch(...)
+    {   // cant create thread
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        startCond.notify_all();
+        for (std::thread& thread: threads)
+            thread.join();
+        throw;
     }
-    
-    /* fix for rounding to one (to nearest value) (if not rounding zeros) */
-    if (!roundingFix && mod != 0 &&
-        ((rescaled[powSize+1] & (oneValue-1)) >= (oneValue>>1)))
-        decValue++;
-    
-    for (uint64_t tmpVal = decValue; tmpVal != 0; )
+}
+
+ThreadPool::~ThreadPool()
+{
     {
-        const uint64_t tmp = tmpVal/10u;
-        const cxuint digit = tmpVal - tmp*10U;
-        buffer[digitsNum++] = '0'+digit;
-        tmpVal = tmp;
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
     }
-    
-    cxuint roundPos = 0;
-    // count roundPos
-    for (roundPos = 0; buffer[roundPos] == '0' && roundPos < digitsNum; roundPos++);
-    
-    if (digitsNum-roundPos > maxSize)
-        throw Exception("Max size is too small");
-    
-    const char* strend = str + maxSize-1;
-    
-    if (signOfValue)
+    startCond.notify_all();
+    for (std::thread& thread: threads)
+        thread.join();
+}
+
+void ThreadPool::threadMain(cxuint threadId)
+{
+    size_t lastGeneration = 0;
+    while (true)
     {
-        if (p >= strend)
-            throw Exception("Max size is too small");
-        *p++ = '-';
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCond.wait(lock, [this, lastGeneration]
+                    { return stopping || generation != lastGeneration; });
+            if (stopping)
+                return;
+            lastGeneration = generation;
+        }
+        runWorker(threadId);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--runningThreads == 0)
+            doneCond.notify_one();
     }
-    
-    cxuint commaPos = digitsNum-1;
-    cxint decExponent = decExpOfValue + digitsNum - 1;
-    if (!scientific)
+}
+
+void ThreadPool::runWorker(cxuint threadId)
+{
+    Worker& self = workers[threadId];
+    while (true)
     {
-        if (decExponent >= -5 && decExponent < 0)
-        {   // over same number
-            if (p+2 > strend)
-                throw Exception("Max size is too small");
-            *p++ = '0';
-            *p++ = '.';
-            for (cxint dx = -1; dx > decExponent; dx--)
+        size_t index = SIZE_MAX;
+        {
+            std::lock_guard<std::mutex> lock(self.mutex);
+            if (self.begin < self.end)
+                index = self.begin++;
+        }
+        if (index == SIZE_MAX)
+        {   // steal half of range of other thread
+            size_t begin = 0, end = 0;
+            for (cxuint i = 1; i < threadsNum && begin == end; i++)
             {
-                if (p >= strend)
-                    throw Exception("Max size is too small");
-                *p++ = '0';
+                Worker& victim = workers[(threadId+i) % threadsNum];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (victim.begin < victim.end)
+                {
+                    begin = victim.begin + (victim.end-victim.begin)/2;
+                    end = victim.end;
+                    victim.end = begin;
+                }
             }
-            commaPos = digitsNum;
+            if (begin == end)
+                return; // no more tasks
+            std::lock_guard<std::mutex> lock(self.mutex);
+            self.begin = begin+1;
+            self.end = end;
+            index = begin;
         }
-        else if (decExponent >= 0 && decExponent <= int(digitsNum-1))
+        if (failed)
+            continue; // skip tasks after failure
+        try
+        { (*task)(index); }
+        catch(...)
         {
-            commaPos = digitsNum - decExponent - 1;
-            roundPos = std::min(commaPos, roundPos);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!failed)
+                error = std::current_exception();
+            failed = true;
         }
     }
-    /* put to string */
-    if (p + digitsNum-roundPos > strend) // out of string
-        throw Exception("Max size is too small");
-    
-    for (cxuint pos = digitsNum; pos > roundPos; pos--)
+}
+
+void ThreadPool::run(size_t tasksNum, const std::function<void(size_t)>& _task)
+{
+    std::lock_guard<std::mutex> runLock(runMutex);
     {
-        *p++ = buffer[pos-1];
-        if (pos-1 == commaPos && pos-1 > roundPos)
-            *p++ = '.';
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &_task;
+        failed = false;
+        error = nullptr;
+        for (cxuint i = 0; i < threadsNum; i++)
+        {
+            std::lock_guard<std::mutex> workerLock(workers[i].mutex);
+            workers[i].begin = tasksNum*i / threadsNum;
+            workers[i].end = tasksNum*(i+1) / threadsNum;
+        }
+        runningThreads = threadsNum-1;
+        generation++;
     }
-    
-    if (p > strend) // out of string
-        throw Exception("Max size is too small");
-        
-    if (scientific || decExponent < -5 || decExponent > int(digitsNum-1))
-    {   /* print exponent */
-        if (p >= strend) // out of string
-            throw Exception("Max size is too small");
-        *p++ = 'e';
-        if (decExponent < 0)
+    startCond.notify_all();
+    runWorker(0);
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCond.wait(lock, [this] { return runningThreads == 0; });
+    task = nullptr;
+    if (error)
+        std::rethrow_exception(error);
+}
+
+/*
+ * lane-parallel parsing of short decimal numbers
+ */
+
+/* max number of digits of short number parsed in SIMD lane */
+static const cxuint SHORT_LANE_DIGITS = 8;
+/* number of lanes (numbers parsed at once) */
+static const cxuint SHORT_LANES_NUM = 4;
+
+/* parse up to 4 short decimal numbers (up to 8 digits, with optional minus and dot
+ * for floating points) at once. Every number is placed to own 8-byte lane (padded by
+ * '0' at left side), then digits of all lanes are validated and accumulated by SIMD.
+ * returns mask of parsed lanes, other lanes must be parsed by scalar functions */
+static cxuint parseShortDecLanes(cxuint lanesNum, const char* const* strs,
+            const char* const* inends, bool isFloat, uint32_t* mantisas,
+            cxuint* fracDigits, cxuint& negMask)
+{
+#ifdef HAVE_SSE2
+    uint64_t slots[SHORT_LANES_NUM] __attribute__((aligned(16)));
+    cxuint mask = 0;
+    negMask = 0;
+    for (cxuint i = 0; i < SHORT_LANES_NUM; i++)
+    {
+        slots[i] = 0x3030303030303030ULL; // all '0'
+        fracDigits[i] = 0;
+        if (i >= lanesNum)
+            continue;
+        const char* p = strs[i];
+        const char* end = inends[i];
+        if (isFloat && p != end && *p == '-')
         {
-            *p++ = '-';
-            decExponent = -decExponent;
+            negMask |= 1U<<i;
+            p++;
+        }
+        const size_t len = end-p;
+        if (len == 0 || len > SHORT_LANE_DIGITS+1)
+            continue;
+        char* slot = (char*)(slots+i);
+        const char* dot = (isFloat) ? (const char*)::memchr(p, '.', len) : nullptr;
+        if (dot == nullptr)
+        {   // leading zero in integer means octal or prefix
+            if (len > SHORT_LANE_DIGITS || (!isFloat && *p == '0' && len > 1))
+                continue;
+            ::memcpy(slot + SHORT_LANE_DIGITS-len, p, len);
         }
         else
-            *p++ = '+';
-        
-        cxuint decExpDigitsNum = 0;
-        if (decExponent != 0)
-            while (decExponent != 0)
-            {
-                const cxint tmp = decExponent/10;
-                const cxint digit = decExponent - tmp*10;
-                buffer[decExpDigitsNum++] = '0' + digit;
-                decExponent = tmp;
-            }
-        else
-        {
-            buffer[0] = '0';
-            decExpDigitsNum = 1;
+        {   // digits required at both sides of dot
+            if (dot == p || dot+1 == end)
+                continue;
+            const size_t fracLen = end-dot-1;
+            ::memcpy(slot + SHORT_LANE_DIGITS-(len-1), p, dot-p);
+            ::memcpy(slot + SHORT_LANE_DIGITS-fracLen, dot+1, fracLen);
+            fracDigits[i] = fracLen;
         }
-        
-        if ((p + decExpDigitsNum) > strend)
-            throw Exception("Max size is too small");
-        
-        for (cxuint pos = decExpDigitsNum; pos > 0; pos--)
-            *p++ = buffer[pos-1];
+        mask |= 1U<<i;
     }
+    if (mask == 0)
+        return 0;
     
-    *p = 0;
-    return p-str;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mul10 = _mm_set1_epi32(0x0001000a); // [10, 1] in 16-bit
+    const __m128i mul100 = _mm_set1_epi32(0x00010064); // [100, 1] in 16-bit
+    __m128i quads[2];
+    for (cxuint k = 0; k < 2; k++)
+    {
+        const __m128i digits = _mm_sub_epi8(_mm_load_si128((const __m128i*)slots + k),
+                    _mm_set1_epi8('0'));
+        // validate digits of two lanes (8 bits of movemask per lane)
+        const cxuint invalid = _mm_movemask_epi8(_mm_or_si128(
+                _mm_cmpgt_epi8(digits, _mm_set1_epi8(9)), _mm_cmplt_epi8(digits, zero)));
+        if ((invalid & 0xff) != 0)
+            mask &= ~(1U<<(2*k));
+        if ((invalid & 0xff00) != 0)
+            mask &= ~(2U<<(2*k));
+        // pairs of digits: 10*a+b
+        const __m128i pairs = _mm_packs_epi32(
+                _mm_madd_epi16(_mm_unpacklo_epi8(digits, zero), mul10),
+                _mm_madd_epi16(_mm_unpackhi_epi8(digits, zero), mul10));
+        // quads of digits: 100*ab+cd
+        quads[k] = _mm_madd_epi16(pairs, mul100);
+    }
+    // values: 10000*abcd+efgh
+    const __m128i values = _mm_madd_epi16(_mm_packs_epi32(quads[0], quads[1]),
+                _mm_set1_epi32(0x00012710));
+    _mm_storeu_si128((__m128i*)mantisas, values);
+    return mask;
+#else
+    return 0;
+#endif
 }
 
-size_t CLRX::htocstrCStyle(cxushort value, char* str, size_t maxSize, bool scientific)
+static inline cxuint parseShortLanes(cxuint lanesNum, const char* const* strs,
+            const char* const* inends, uint32_t* values)
 {
-    return fXtocstrCStyle(value, str, maxSize, scientific, 5, 10);
+    cxuint fracDigits[SHORT_LANES_NUM], negMask;
+    uint32_t mantisas[SHORT_LANES_NUM];
+    const cxuint mask = parseShortDecLanes(lanesNum, strs, inends, false, mantisas,
+                fracDigits, negMask);
+    for (cxuint i = 0; i < lanesNum; i++)
+        if ((mask & (1U<<i)) != 0)
+            values[i] = mantisas[i];
+    return mask;
 }
 
-size_t CLRX::ftocstrCStyle(float value, char* str, size_t maxSize, bool scientific)
+static inline cxuint parseShortLanes(cxuint lanesNum, const char* const* strs,
+            const char* const* inends, uint64_t* values)
 {
-    FloatUnion v;
-    v.f = value;
-    return fXtocstrCStyle(v.u, str, maxSize, scientific, 8, 23);
+    cxuint fracDigits[SHORT_LANES_NUM], negMask;
+    uint32_t mantisas[SHORT_LANES_NUM];
+    const cxuint mask = parseShortDecLanes(lanesNum, strs, inends, false, mantisas,
+                fracDigits, negMask);
+    for (cxuint i = 0; i < lanesNum; i++)
+        if ((mask & (1U<<i)) != 0)
+            values[i] = mantisas[i];
+    return mask;
 }
 
-size_t CLRX::dtocstrCStyle(double value, char* str, size_t maxSize, bool scientific)
+/* no lane-parallel parsing for half floats */
+static inline cxuint parseShortLanes(cxuint lanesNum, const char* const* strs,
+            const char* const* inends, cxushort* values)
 {
-    DoubleUnion v;
-    v.d = value;
-    return fXtocstrCStyle(v.u, str, maxSize, scientific, 11, 52);
+    return 0;
 }
 
-size_t CLRX::u32tocstrCStyle(uint32_t value, char* str, size_t maxSize, cxuint radix,
-             cxuint width, bool prefix)
+/* values are mantisa/10**fracDigits. result of division is correctly rounded,
+ * because mantisa and power of 10 are exact (for floats: mantisa up to 2**24) */
+static inline cxuint parseShortLanes(cxuint lanesNum, const char* const* strs,
+            const char* const* inends, float* values)
 {
-    return u64tocstrCStyle(value, str, maxSize, radix, width, prefix);
+#ifdef HAVE_SSE2
+    static const float power10sF[SHORT_LANE_DIGITS+1] =
+    { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f };
+    cxuint fracDigits[SHORT_LANES_NUM], negMask;
+    uint32_t mantisas[SHORT_LANES_NUM];
+    cxuint mask = parseShortDecLanes(lanesNum, strs, inends, true, mantisas,
+                fracDigits, negMask);
+    if (mask == 0)
+        return 0;
+    float signs[SHORT_LANES_NUM];
+    for (cxuint i = 0; i < SHORT_LANES_NUM; i++)
+    {
+        if (mantisas[i] > (1U<<24))
+            mask &= ~(1U<<i);
+        signs[i] = ((negMask & (1U<<i)) != 0) ? -0.0f : 0.0f;
+    }
+    const __m128 out = _mm_xor_ps(_mm_div_ps(
+            _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)mantisas)),
+            _mm_setr_ps(power10sF[fracDigits[0]], power10sF[fracDigits[1]],
+                        power10sF[fracDigits[2]], power10sF[fracDigits[3]])),
+            _mm_loadu_ps(signs));
+    float outValues[SHORT_LANES_NUM];
+    _mm_storeu_ps(outValues, out);
+    for (cxuint i = 0; i < lanesNum; i++)
+        if ((mask & (1U<<i)) != 0)
+            values[i] = outValues[i];
+    return mask;
+#else
+    return 0;
+#endif
 }
 
-size_t CLRX::u64tocstrCStyle(uint64_t value, char* str, size_t maxSize, cxuint radix,
-            cxuint width, bool prefix)
+static inline cxuint parseShortLanes(cxuint lanesNum, const char* const* strs,
+            const char* const* inends, double* values)
 {
-    cxuint digitsNum = 0;
-    char buffer[64];
+#ifdef HAVE_SSE2
+    static const double power10sD[SHORT_LANE_DIGITS+1] =
+    { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8 };
+    cxuint fracDigits[SHORT_LANES_NUM], negMask;
+    uint32_t mantisas[SHORT_LANES_NUM];
+    const cxuint mask = parseShortDecLanes(lanesNum, strs, inends, true, mantisas,
+                fracDigits, negMask);
+    if (mask == 0)
+        return 0;
+    double signs[SHORT_LANES_NUM];
+    for (cxuint i = 0; i < SHORT_LANES_NUM; i++)
+        signs[i] = ((negMask & (1U<<i)) != 0) ? -0.0 : 0.0;
+    const __m128i mantisasV = _mm_loadu_si128((const __m128i*)mantisas);
+    double outValues[SHORT_LANES_NUM];
+    _mm_storeu_pd(outValues, _mm_xor_pd(_mm_div_pd(_mm_cvtepi32_pd(mantisasV),
+            _mm_setr_pd(power10sD[fracDigits[0]], power10sD[fracDigits[1]])),
+            _mm_loadu_pd(signs)));
+    _mm_storeu_pd(outValues+2, _mm_xor_pd(_mm_div_pd(
+            _mm_cvtepi32_pd(_mm_srli_si128(mantisasV, 8)),
+            _mm_setr_pd(power10sD[fracDigits[2]], power10sD[fracDigits[3]])),
+            _mm_loadu_pd(signs+2)));
+    for (cxuint i = 0; i < lanesNum; i++)
+        if ((mask & (1U<<i)) != 0)
+            values[i] = outValues[i];
+    return mask;
+#else
+    return 0;
+#endif
+}
 
-    char* strend = str + maxSize-1;
-    char* p = str;
-    switch(radix)
+template<typename T, typename ParseElem>
+static void cstrtoFieldsCStyle(size_t n, const char* const* strs,
+            const char* const* inends, T* values, ParseElem parseElem)
+{
+    for (size_t i = 0; i < n; i += SHORT_LANES_NUM)
     {
-        case 2:
-            if (prefix)
-            {
-                if (p+2 >= strend)
-                    throw Exception("Max size is too small");
-                *p++ = '0';
-                *p++ = 'b';
-            }
-            for (uint64_t tval = value; tval != 0; digitsNum++)
-            {
-                const cxuint digit = tval&1;
-                buffer[digitsNum] = '0'+digit;
-                tval = tval>>1;
+        const cxuint lanesNum = std::min(size_t(SHORT_LANES_NUM), n-i);
+        const cxuint mask = parseShortLanes(lanesNum, strs+i, inends+i, values+i);
+        for (cxuint l = 0; l < lanesNum; l++)
+            if ((mask & (1U<<l)) == 0)
+            {   // parse by scalar function
+                const char* outend;
+                values[i+l] = parseElem(strs[i+l], inends[i+l], outend);
+                if (outend != inends[i+l])
+                    throw ParseException("Garbage at end of number");
             }
-            break;
-        case 8:
-            if (prefix)
+    }
+}
+
+void CLRX::cstrtou32FieldsCStyle(size_t n, const char* const* strs,
+            const char* const* inends, uint32_t* values)
+{
+    cstrtoFieldsCStyle(n, strs, inends, values, cstrtou32CStyle);
+}
+
+void CLRX::cstrtou64FieldsCStyle(size_t n, const char* const* strs,
+            const char* const* inends, uint64_t* values)
+{
+    cstrtoFieldsCStyle(n, strs, inends, values, cstrtou64CStyle);
+}
+
+void CLRX::cstrtofFieldsCStyle(size_t n, const char* const* strs,
+            const char* const* inends, float* values)
+{
+    cstrtoFieldsCStyle(n, strs, inends, values, cstrtofCStyle);
+}
+
+void CLRX::cstrtodFieldsCStyle(size_t n, const char* const* strs,
+            const char* const* inends, double* values)
+{
+    cstrtoFieldsCStyle(n, strs, inends, values, cstrtodCStyle);
+}
+
+/*
+ * parallel parsing of arrays (split string at delimiters, count elements of chunks,
+ * prefix sum and parsing chunks)
+ */
+
+/* minimal size of chunk of string in parallel parsing */
+static const size_t PARALLEL_PARSE_MIN_CHUNK = 65536;
+
+static inline bool isParseSpace(char c)
+{ return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+template<typename T, typename ParseElem>
+static size_t cstrtoArrayParallelCStyle(const char* str, const char* inend,
+        size_t maxValuesNum, T* values, std::vector<CStrArrayParseError>& errors,
+        ThreadPool& pool, char delimiter, ParseElem parseElem)
+{
+    errors.clear();
+    // elements are in str...end, end is treated as delimiter
+    const char* end = inend;
+    while (end != str && end[-1] != delimiter && isParseSpace(end[-1])) end--;
+    if (end == str || end[-1] == delimiter)
+    {   // last element is empty
+        if (end == str)
+            return 0;
+        end--;
+    }
+    
+    // split string at delimiters
+    const size_t size = end-str;
+    const size_t chunksNum = std::max(size_t(1), std::min(size/PARALLEL_PARSE_MIN_CHUNK,
+                size_t(pool.getThreadsNum())*8));
+    // using vector for prevents memory leaks (function can throw exception)
+    // offsets of chunks (size+1 - after virtual delimiter at end)
+    std::vector<size_t> chunkStarts(chunksNum+1);
+    chunkStarts[0] = 0;
+    chunkStarts[chunksNum] = size+1;
+    for (size_t i = 1; i < chunksNum; i++)
+    {
+        const size_t start = std::max(chunkStarts[i-1], size*i/chunksNum);
+        const char* p = (start < size) ? (const char*)::memchr(str+start, delimiter,
+                    size-start) : nullptr;
+        chunkStarts[i] = (p != nullptr) ? p+1-str : size+1;
+    }
+    // count elements of chunks
+    std::vector<size_t> chunkIndices(chunksNum+1);
+    pool.run(chunksNum, [&](size_t chunk)
+    {
+        size_t count = 0;
+        const char* chunkEnd = str + std::min(chunkStarts[chunk+1], size);
+        for (const char* p = str + std::min(chunkStarts[chunk], size); p < chunkEnd; p++)
+        {
+            p = (const char*)::memchr(p, delimiter, chunkEnd-p);
+            if (p == nullptr)
+                break;
+            count++;
+        }
+        if (chunkStarts[chunk+1] == size+1 && chunkStarts[chunk] != size+1)
+            count++; // last element
+        chunkIndices[chunk+1] = count;
+    });
+    for (size_t chunk = 0; chunk < chunksNum; chunk++)
+        chunkIndices[chunk+1] += chunkIndices[chunk];
+    const size_t valuesNum = chunkIndices[chunksNum];
+    if (valuesNum > maxValuesNum)
+        throw Exception("Too many numbers in string");
+    
+    // parse chunks
+    std::vector<std::vector<CStrArrayParseError> > chunkErrors(chunksNum);
+    pool.run(chunksNum, [&](size_t chunk)
+    {
+        size_t index = chunkIndices[chunk];
+        const size_t chunkEnd = chunkStarts[chunk+1];
+        for (size_t start = chunkStarts[chunk]; start < chunkEnd;)
+        {
+            // collect elements for lanes
+            const char* elemStrs[SHORT_LANES_NUM];
+            const char* elemEnds[SHORT_LANES_NUM];
+            cxuint lanesNum = 0;
+            for (; lanesNum < SHORT_LANES_NUM && start < chunkEnd; lanesNum++)
             {
-                if (p+1 >= strend)
-                    throw Exception("Max size is too small");
-                *p++ = '0';
+                const char* p = str + start;
+                const char* elemEnd = (const char*)::memchr(p, delimiter,
+                            std::min(chunkEnd, size)-start);
+                if (elemEnd == nullptr)
+                    elemEnd = end;
+                start = elemEnd+1-str;
+                while (p != elemEnd && isParseSpace(*p)) p++;
+                while (elemEnd != p && isParseSpace(elemEnd[-1])) elemEnd--;
+                elemStrs[lanesNum] = p;
+                elemEnds[lanesNum] = elemEnd;
             }
-            for (uint64_t tval = value; tval != 0; digitsNum++)
+            const cxuint mask = parseShortLanes(lanesNum, elemStrs, elemEnds,
+                        values+index);
+            for (cxuint l = 0; l < lanesNum; l++, index++)
             {
-                const cxuint digit = tval&7;
-                buffer[digitsNum] = '0'+digit;
-                tval = tval>>3;
-            }
-            break;
-        case 10:
-            if (value > UINT32_MAX)
-                for (uint64_t tval = value; tval != 0; digitsNum++)
-                {
-                    const uint64_t tmp = tval/10U;
-                    const cxuint digit = tval - tmp*10U;
-                    buffer[digitsNum] = '0'+digit;
-                    tval = tmp;
-                }
-            else // for speed
-                for (uint32_t tval = value; tval != 0; digitsNum++)
+                if ((mask & (1U<<l)) != 0)
+                    continue;
+                // parse by scalar function
+                values[index] = 0;
+                std::string message;
+                try
                 {
-                    const uint32_t tmp = tval/10U;
-                    const cxuint digit = tval - tmp*10U;
-                    buffer[digitsNum] = '0'+digit;
-                    tval = tmp;
+                    const char* outend;
+                    const T value = parseElem(elemStrs[l], elemEnds[l], outend);
+                    if (outend != elemEnds[l])
+                        message = "Garbage at end of number";
+                    else
+                        values[index] = value;
                 }
-            break;
-        case 16:
-            if (prefix)
-            {
-                if (p+2 >= strend)
-                    throw Exception("Max size is too small");
-                *p++ = '0';
-                *p++ = 'x';
+                catch(const ParseException& ex)
+                { message = ex.what(); }
+                if (!message.empty())
+                    chunkErrors[chunk].push_back({ index, size_t(elemStrs[l]-str),
+                                message });
             }
-            for (uint64_t tval = value; tval != 0; digitsNum++)
-            {
-                const cxuint digit = tval&15;
-                buffer[digitsNum] = (digit < 10) ? ('0'+digit) : ('a'+digit-10);
-                tval = tval>>4;
-            }
-            break;
-        default:
-            throw Exception("Unknown radix");
-            break;
-    }
+        }
+    });
+    for (const std::vector<CStrArrayParseError>& chunkError: chunkErrors)
+        errors.insert(errors.end(), chunkError.begin(), chunkError.end());
+    return valuesNum;
+}
 
-    // if zero
-    if (value == 0)
-        buffer[digitsNum++] = '0';
+size_t CLRX::cstrtou32ArrayParallelCStyle(const char* str, const char* inend,
+        size_t maxValuesNum, uint32_t* values, std::vector<CStrArrayParseError>& errors,
+        ThreadPool& pool, char delimiter)
+{
+    return cstrtoArrayParallelCStyle(str, inend, maxValuesNum, values, errors, pool,
+                delimiter, cstrtou32CStyle);
+}
 
-    if (p+digitsNum > strend || p+width > strend)
-        throw Exception("Max size is too small");
+size_t CLRX::cstrtou64ArrayParallelCStyle(const char* str, const char* inend,
+        size_t maxValuesNum, uint64_t* values, std::vector<CStrArrayParseError>& errors,
+        ThreadPool& pool, char delimiter)
+{
+    return cstrtoArrayParallelCStyle(str, inend, maxValuesNum, values, errors, pool,
+                delimiter, cstrtou64CStyle);
+}
 
-    if (digitsNum < width)
-    {
-        const char fillchar = (radix == 10)?' ':'0';
-        for (cxuint pos = 0; pos < width-digitsNum; pos++)
-            *p++ = fillchar;
-    }
+size_t CLRX::cstrtohArrayParallelCStyle(const char* str, const char* inend,
+        size_t maxValuesNum, cxushort* values, std::vector<CStrArrayParseError>& errors,
+        ThreadPool& pool, char delimiter)
+{
+    return cstrtoArrayParallelCStyle(str, inend, maxValuesNum, values, errors, pool,
+                delimiter, cstrtohCStyle);
+}
 
-    for (cxuint pos = digitsNum; pos > 0; pos--)
-        *p++ = buffer[pos-1];
+size_t CLRX::cstrtofArrayParallelCStyle(const char* str, const char* inend,
+        size_t maxValuesNum, float* values, std::vector<CStrArrayParseError>& errors,
+        ThreadPool& pool, char delimiter)
+{
+    return cstrtoArrayParallelCStyle(str, inend, maxValuesNum, values, errors, pool,
+                delimiter, cstrtofCStyle);
+}
 
-    *p = 0;
-    return p-str;
+size_t CLRX::cstrtodArrayParallelCStyle(const char* str, const char* inend,
+        size_t maxValuesNum, double* values, std::vector<CStrArrayParseError>& errors,
+        ThreadPool& pool, char delimiter)
+{
+    return cstrtoArrayParallelCStyle(str, inend, maxValuesNum, values, errors, pool,
+                delimiter, cstrtodCStyle);
 }
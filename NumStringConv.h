@@ -24,11 +24,19 @@
 #define __NUMSTRINGCONV_H__
 
 #include <exception>
+#include <algorithm>
 #include <string>
 #include <cstdlib>
 #include <cstring>
 #include <cstdint>
+#include <climits>
 #include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <memory>
+#include <vector>
 
 /** HAVE_INT128 - enable GCC __int128 support for faster multiplication */
 #if defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__==8 && defined(__GNUC__)
@@ -172,6 +180,75 @@ extern uint32_t cstrtou32CStyle(const char* str, const char* inend, const char*&
  */
 extern uint64_t cstrtou64CStyle(const char* str, const char* inend, const char*& outend);
 
+/// parse big unsigned integer formatted looks like C-style
+/** parses unsigned integer of any length from str string to array of 64-bit limbs
+ * (in little endian order). inend can points to end of string or can be null.
+ * Function throws ParseException when number in string is out of range (does not fit
+ * in size limbs), when string does not have number or inend points to string.
+ * Function accepts decimal format, octal form (with prefix '0'), hexadecimal form
+ * (prefix '0x' or '0X'), and binary form (prefix '0b' or '0B').
+ * Long decimal numbers are converted in subquadratic time.
+ * WARNING: Function does not skip first spaces.
+ * \param str input string pointer
+ * \param inend pointer points to end of string or null if not end specified
+ * \param outend returns end of number in string
+ * \param size size of output number in 64-bit limbs
+ * \param bigNum output number (unused upper limbs are zeroed)
+ */
+extern void cstrtobigCStyle(const char* str, const char* inend, const char*& outend,
+            cxuint size, uint64_t* bigNum);
+
+/// parse 128-bit unsigned formatted looks like C-style
+/** parses 128-bit unsigned integer from str string to two 64-bit limbs (in little
+ * endian order). inend can points to end of string or can be null.
+ * Function throws ParseException when number in string is out of range,
+ * when string does not have number or inend points to string.
+ * Function accepts decimal format, octal form (with prefix '0'), hexadecimal form
+ * (prefix '0x' or '0X'), and binary form (prefix '0b' or '0B').
+ * WARNING: Function does not skip first spaces.
+ * \param str input string pointer
+ * \param inend pointer points to end of string or null if not end specified
+ * \param outend returns end of number in string
+ * \param value output value (two limbs)
+ */
+extern void cstrtou128CStyle(const char* str, const char* inend, const char*& outend,
+            uint64_t* value);
+
+/// parse 128-bit signed formatted looks like C-style
+/** parses 128-bit signed integer (with optional minus) from str string to two 64-bit
+ * limbs (two's complement, little endian order). inend can points to end of string
+ * or can be null. Function throws ParseException when number in string is out of range,
+ * when string does not have number or inend points to string.
+ * Function accepts decimal format, octal form (with prefix '0'), hexadecimal form
+ * (prefix '0x' or '0X'), and binary form (prefix '0b' or '0B').
+ * WARNING: Function does not skip first spaces.
+ * \param str input string pointer
+ * \param inend pointer points to end of string or null if not end specified
+ * \param outend returns end of number in string
+ * \param value output value (two limbs)
+ */
+extern void cstrtoi128CStyle(const char* str, const char* inend, const char*& outend,
+            uint64_t* value);
+
+#ifdef HAVE_INT128
+/// parse 128-bit unsigned formatted looks like C-style (native type)
+inline unsigned __int128 cstrtou128CStyle(const char* str, const char* inend,
+            const char*& outend)
+{
+    uint64_t value[2];
+    cstrtou128CStyle(str, inend, outend, value);
+    return (((unsigned __int128)value[1])<<64) | value[0];
+}
+
+/// parse 128-bit signed formatted looks like C-style (native type)
+inline __int128 cstrtoi128CStyle(const char* str, const char* inend, const char*& outend)
+{
+    uint64_t value[2];
+    cstrtoi128CStyle(str, inend, outend, value);
+    return (((unsigned __int128)value[1])<<64) | value[0];
+}
+#endif
+
 /// parse half float formatted looks like C-style
 /** parses half floating point from str string. inend can points
  * to end of string or can be null. Function throws ParseException when number in string
@@ -217,6 +294,353 @@ extern float cstrtofCStyle(const char* str, const char* inend, const char*& oute
  */
 extern double cstrtodCStyle(const char* str, const char* inend, const char*& outend);
 
+/// resumable parser of unsigned integers formatted looks like C-style
+/** parser can be fed by successive fragments of string, and keeps only state
+ * of parsing (accumulated value and kind of number), so number can be split
+ * between many buffers. Result and errors are same as for cstrtouXCStyle functions.
+ */
+class UIntIncrParser
+{
+private:
+    cxuint bits;
+    cxuint state;
+    uint64_t value;
+public:
+    /// constructor
+    /** \param bits number of bits of value (8, 16, 32 or 64) */
+    explicit UIntIncrParser(cxuint bits = 64);
+    
+    /// reset parser (for next number)
+    void reset();
+    
+    /// feed parser by next fragment of string
+    /** Function throws ParseException when number is out of range or
+     * number is not correct.
+     * \param str fragment pointer
+     * \param inend pointer to end of fragment
+     * \return end of number in fragment or inend if number can be continued
+     */
+    const char* feed(const char* str, const char* inend);
+    
+    /// returns true if end of number has been found by feed
+    bool isFinished() const;
+    
+    /// finish parsing (at end of number or end of input) and return value
+    /** Function throws ParseException when number is not complete. */
+    uint64_t finish();
+};
+
+/// resumable parser of floating points formatted looks like C-style
+/** parser can be fed by successive fragments of string. Parser does not rescan
+ * earlier fragments: it keeps only state (sign, exponent, significant digits
+ * needed to correct rounding and sticky bit for further nonzero digits).
+ * Result is correctly rounded and same as for cstrtofXCStyle functions.
+ * Floating point format is given by number of bits of exponent and mantisa:
+ * half - (5, 10), single - (8, 23), double - (11, 52).
+ */
+class FloatIncrParser
+{
+public:
+    /// max number of significant digits kept by parser
+    static const cxuint MAX_DIGITS = 800;
+private:
+    cxuint expBits, mantisaBits;
+    cxuint maxDigits;
+    cxuint state;
+    bool negative;
+    bool hex;
+    bool comma;
+    bool firstDigitFound;
+    bool sticky;
+    bool expNegative;
+    cxuint specialMatched;
+    size_t valueChars;
+    int64_t valueExp;
+    cxuint absExponent;
+    cxuint digitsNum;
+    char digits[MAX_DIGITS];
+    
+    void endValue();
+    void endExponent();
+public:
+    /// constructor
+    /**
+     * \param expBits number of bits of exponent
+     * \param mantisaBits number of bits of mantisa
+     */
+    explicit FloatIncrParser(cxuint expBits = 11, cxuint mantisaBits = 52);
+    
+    /// reset parser (for next number)
+    void reset();
+    
+    /// feed parser by next fragment of string
+    /** Function throws ParseException when number is not correct.
+     * \param str fragment pointer
+     * \param inend pointer to end of fragment
+     * \return end of number in fragment or inend if number can be continued
+     */
+    const char* feed(const char* str, const char* inend);
+    
+    /// returns true if end of number has been found by feed
+    bool isFinished() const;
+    
+    /// finish parsing (at end of number or end of input) and return bits of value
+    /** Function throws ParseException when number is not complete or out of range. */
+    uint64_t finish();
+};
+
+/// segment of segmented string (for example part of rope or scatter/gather buffer)
+struct CStrSegment
+{
+    const char* str;    ///< pointer to segment
+    const char* inend;  ///< pointer to end of segment
+};
+
+/// position in segmented string
+struct CStrSegmentPos
+{
+    size_t segment;     ///< index of segment
+    const char* ptr;    ///< pointer in segment
+};
+
+/// parse 32-bit unsigned integer from segmented string
+/** Parsing begins at start of first segment. Number inside single segment is parsed
+ * directly, only number that spans segments is fed by segments to resumable parser
+ * (segments are not gathered in memory). Function throws ParseException like
+ * cstrtou32CStyle. If number ends at end of segment, then outpos can point to
+ * begin of next segment.
+ * \param segmentsNum number of segments
+ * \param segments segments of string
+ * \param outpos returned position after number
+ * \return parsed integer value
+ */
+extern uint32_t cstrtou32SegmentsCStyle(size_t segmentsNum, const CStrSegment* segments,
+        CStrSegmentPos& outpos);
+
+/// parse 64-bit unsigned integer from segmented string
+/** works like cstrtou32SegmentsCStyle, but parses 64-bit integer */
+extern uint64_t cstrtou64SegmentsCStyle(size_t segmentsNum, const CStrSegment* segments,
+        CStrSegmentPos& outpos);
+
+/// parse half floating point from segmented string
+/** works like cstrtou32SegmentsCStyle, but parses half floating point
+ * and returns bits of value */
+extern cxushort cstrtohSegmentsCStyle(size_t segmentsNum, const CStrSegment* segments,
+        CStrSegmentPos& outpos);
+
+/// parse single floating point from segmented string
+/** works like cstrtou32SegmentsCStyle, but parses single floating point */
+extern float cstrtofSegmentsCStyle(size_t segmentsNum, const CStrSegment* segments,
+        CStrSegmentPos& outpos);
+
+/// parse double floating point from segmented string
+/** works like cstrtou32SegmentsCStyle, but parses double floating point */
+extern double cstrtodSegmentsCStyle(size_t segmentsNum, const CStrSegment* segments,
+        CStrSegmentPos& outpos);
+
+/// parse 32-bit unsigned integer from string of wide characters
+/** works like cstrtou32CStyle, but parses string of code units of CharType
+ * (char, char16_t, char32_t or wchar_t). Wide code units are narrowed to ASCII in small
+ * blocks (by SIMD code if available), number longer than block is parsed by resumable
+ * parser. Version for char just calls cstrtou32CStyle.
+ * \param str input string pointer
+ * \param inend pointer to end of string
+ * \param outend returned end of number
+ * \return parsed integer value
+ */
+template<typename CharType>
+uint32_t cstrtou32WideCStyle(const CharType* str, const CharType* inend,
+        const CharType*& outend);
+
+/// parse 64-bit unsigned integer from string of wide characters
+/** works like cstrtou32WideCStyle, but parses 64-bit integer */
+template<typename CharType>
+uint64_t cstrtou64WideCStyle(const CharType* str, const CharType* inend,
+        const CharType*& outend);
+
+/// parse half floating point from string of wide characters
+/** works like cstrtohCStyle, but parses string of code units of CharType
+ * (char, char16_t, char32_t or wchar_t) */
+template<typename CharType>
+cxushort cstrtohWideCStyle(const CharType* str, const CharType* inend,
+        const CharType*& outend);
+
+/// parse single floating point from string of wide characters
+/** works like cstrtofCStyle, but parses string of code units of CharType
+ * (char, char16_t, char32_t or wchar_t) */
+template<typename CharType>
+float cstrtofWideCStyle(const CharType* str, const CharType* inend,
+        const CharType*& outend);
+
+/// parse double floating point from string of wide characters
+/** works like cstrtodCStyle, but parses string of code units of CharType
+ * (char, char16_t, char32_t or wchar_t) */
+template<typename CharType>
+double cstrtodWideCStyle(const CharType* str, const CharType* inend,
+        const CharType*& outend);
+
+template<>
+inline uint32_t cstrtou32WideCStyle<char>(const char* str, const char* inend,
+        const char*& outend)
+{ return cstrtou32CStyle(str, inend, outend); }
+
+template<>
+inline uint64_t cstrtou64WideCStyle<char>(const char* str, const char* inend,
+        const char*& outend)
+{ return cstrtou64CStyle(str, inend, outend); }
+
+template<>
+inline cxushort cstrtohWideCStyle<char>(const char* str, const char* inend,
+        const char*& outend)
+{ return cstrtohCStyle(str, inend, outend); }
+
+template<>
+inline float cstrtofWideCStyle<char>(const char* str, const char* inend,
+        const char*& outend)
+{ return cstrtofCStyle(str, inend, outend); }
+
+template<>
+inline double cstrtodWideCStyle<char>(const char* str, const char* inend,
+        const char*& outend)
+{ return cstrtodCStyle(str, inend, outend); }
+
+/// parse short 32-bit unsigned integers in groups
+/** parses n numbers, number i is in string from strs[i] to inends[i] and whole
+ * string must be a number. Short decimal numbers (up to 8 digits) are parsed in groups
+ * of 4 numbers by lane-parallel SIMD code, other numbers by cstrtou32CStyle.
+ * Function throws ParseException if any number can not be parsed.
+ * \param n number of numbers
+ * \param strs pointers to strings of numbers
+ * \param inends pointers to ends of strings of numbers
+ * \param values output values
+ */
+extern void cstrtou32FieldsCStyle(size_t n, const char* const* strs,
+        const char* const* inends, uint32_t* values);
+
+/// parse short 64-bit unsigned integers in groups
+/** works like cstrtou32FieldsCStyle, but parses 64-bit integers */
+extern void cstrtou64FieldsCStyle(size_t n, const char* const* strs,
+        const char* const* inends, uint64_t* values);
+
+/// parse short single floats in groups
+/** works like cstrtou32FieldsCStyle, but parses single floats. Simple decimal numbers
+ * (optional minus, up to 8 digits with optional dot) are parsed by lane-parallel code,
+ * other numbers by cstrtofCStyle */
+extern void cstrtofFieldsCStyle(size_t n, const char* const* strs,
+        const char* const* inends, float* values);
+
+/// parse short double floats in groups
+/** works like cstrtofFieldsCStyle, but parses double floats */
+extern void cstrtodFieldsCStyle(size_t n, const char* const* strs,
+        const char* const* inends, double* values);
+
+/// pool of threads
+/** pool keeps threads between calls of run. Tasks are distributed between threads
+ * as ranges of indices. Thread that finished own range steals half of range
+ * of other thread (work stealing). Calling thread is used as one of threads.
+ */
+class ThreadPool
+{
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        size_t begin, end; // range of tasks
+    };
+    cxuint threadsNum;
+    std::unique_ptr<Worker[]> workers;
+    std::vector<std::thread> threads;
+    std::mutex runMutex; // serializes calls of run
+    std::mutex mutex;
+    std::condition_variable startCond;
+    std::condition_variable doneCond;
+    const std::function<void(size_t)>* task;
+    size_t generation;
+    cxuint runningThreads;
+    bool stopping;
+    std::atomic<bool> failed;
+    std::exception_ptr error;
+    
+    void threadMain(cxuint threadId);
+    void runWorker(cxuint threadId);
+public:
+    /// constructor
+    /** \param threadsNum number of threads (0 - number of hardware threads) */
+    explicit ThreadPool(cxuint threadsNum = 0);
+    /// destructor
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    /// get number of threads (including calling thread)
+    cxuint getThreadsNum() const
+    { return threadsNum; }
+    
+    /// run task for all indices from 0 to tasksNum-1
+    /** function returns when all tasks are done. If any task throws exception,
+     * then remaining tasks are skipped and first exception is rethrown */
+    void run(size_t tasksNum, const std::function<void(size_t)>& task);
+};
+
+/// error of parsing of element of array
+struct CStrArrayParseError
+{
+    size_t index;   ///< index of element
+    size_t offset;  ///< offset of element in input string
+    std::string message;    ///< error message
+};
+
+/// parse array of 32-bit unsigned integers in parallel
+/** parses numbers separated by delimiter from string (from str to inend).
+ * Spaces around numbers are skipped, last element is ignored if it is empty.
+ * String is split to chunks at delimiters and chunks are parsed by threads of pool.
+ * Values are stored in input order. If element can not be parsed, then
+ * its value is zero and error with its index is added to errors (sorted by index).
+ * Function throws exception if number of elements is greater than maxValuesNum.
+ * \param str input string pointer
+ * \param inend pointer points to end of string
+ * \param maxValuesNum max number of values
+ * \param values output values
+ * \param errors returns errors of elements
+ * \param pool thread pool
+ * \param delimiter delimiter between elements
+ * \return number of elements
+ */
+extern size_t cstrtou32ArrayParallelCStyle(const char* str, const char* inend,
+        size_t maxValuesNum, uint32_t* values, std::vector<CStrArrayParseError>& errors,
+        ThreadPool& pool, char delimiter = '\n');
+
+/// parse array of 64-bit unsigned integers in parallel
+/** works like cstrtou32ArrayParallelCStyle, but parses 64-bit integers */
+extern size_t cstrtou64ArrayParallelCStyle(const char* str, const char* inend,
+        size_t maxValuesNum, uint64_t* values, std::vector<CStrArrayParseError>& errors,
+        ThreadPool& pool, char delimiter = '\n');
+
+/// parse array of half floats in parallel
+/** works like cstrtou32ArrayParallelCStyle, but parses half floats */
+extern size_t cstrtohArrayParallelCStyle(const char* str, const char* inend,
+        size_t maxValuesNum, cxushort* values, std::vector<CStrArrayParseError>& errors,
+        ThreadPool& pool, char delimiter = '\n');
+
+/// parse array of single floats in parallel
+/** works like cstrtou32ArrayParallelCStyle, but parses single floats */
+extern size_t cstrtofArrayParallelCStyle(const char* str, const char* inend,
+        size_t maxValuesNum, float* values, std::vector<CStrArrayParseError>& errors,
+        ThreadPool& pool, char delimiter = '\n');
+
+/// parse array of double floats in parallel
+/** works like cstrtou32ArrayParallelCStyle, but parses double floats */
+extern size_t cstrtodArrayParallelCStyle(const char* str, const char* inend,
+        size_t maxValuesNum, double* values, std::vector<CStrArrayParseError>& errors,
+        ThreadPool& pool, char delimiter = '\n');
+
+/// uXtocstrCStyle flag: print hexadecimal digits and prefix letters in uppercase
+const cxuint UXTOCSTR_UPPERCASE = 1;
+/// uXtocstrCStyle flag: separate groups of digits by '_' (4 digits for radix 2 and 16,
+/// 3 digits for radix 8 and 10)
+const cxuint UXTOCSTR_GROUP_DIGITS = 2;
+
 /// format 32-bit unsigned integer
 /** format 32-bit unsigned integer in C-style formatting.
  * \param value integer value
@@ -225,23 +649,66 @@ extern double cstrtodCStyle(const char* str, const char* inend, const char*& out
  * \param radix radix of digits (2, 8, 10, 16)
  * \param width max number of digits in number
  * \param prefix adds required prefix if true
+ * \param flags UXTOCSTR_UPPERCASE and UXTOCSTR_GROUP_DIGITS flags
  * \return length of output string (excluding null-character)
  */
 extern size_t u32tocstrCStyle(uint32_t value, char* str, size_t maxSize, cxuint radix = 10,
-       cxuint width = 0, bool prefix = true);
+       cxuint width = 0, bool prefix = true, cxuint flags = 0);
 
 /// format 64-bit unsigned integer
-/** format 64-bit unsigned integer in C-style formatting.
+/** format 64-bit unsigned integer in C-style formatting. If digits are grouped then
+ * zeroes that fill number to width are grouped too.
  * \param value integer value
  * \param str output string
  * \param maxSize max size of string (including null-character)
  * \param radix radix of digits (2, 8, 10, 16)
  * \param width max number of digits in number
  * \param prefix adds required prefix if true
+ * \param flags UXTOCSTR_UPPERCASE and UXTOCSTR_GROUP_DIGITS flags
  * \return length of output string (excluding null-character)
  */
 extern size_t u64tocstrCStyle(uint64_t value, char* str, size_t maxSize, cxuint radix = 10,
-        cxuint width = 0, bool prefix = true);
+        cxuint width = 0, bool prefix = true, cxuint flags = 0);
+
+/// format big unsigned integer
+/** format big unsigned integer in C-style formatting. Number is stored in little endian
+ * order of 64-bit limbs. Digits in radix 2, 8, 16 are extracted directly, long decimal
+ * numbers are converted in subquadratic time.
+ * \param size size of number in 64-bit limbs
+ * \param bigNum number
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param radix radix of digits (2, 8, 10, 16)
+ * \param width max number of digits in number
+ * \param prefix adds required prefix if true
+ * \return length of output string (excluding null-character)
+ */
+extern size_t bigtocstrCStyle(cxuint size, const uint64_t* bigNum, char* str,
+        size_t maxSize, cxuint radix = 10, cxuint width = 0, bool prefix = true);
+
+/// format 128-bit unsigned integer
+/** format 128-bit unsigned integer (two 64-bit limbs in little endian order)
+ * in C-style formatting.
+ * \param value integer value (two limbs)
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param radix radix of digits (2, 8, 10, 16)
+ * \param width max number of digits in number
+ * \param prefix adds required prefix if true
+ * \return length of output string (excluding null-character)
+ */
+extern size_t u128tocstrCStyle(const uint64_t* value, char* str, size_t maxSize,
+        cxuint radix = 10, cxuint width = 0, bool prefix = true);
+
+#ifdef HAVE_INT128
+/// format 128-bit unsigned integer (native type)
+inline size_t u128tocstrCStyle(unsigned __int128 value, char* str, size_t maxSize,
+        cxuint radix = 10, cxuint width = 0, bool prefix = true)
+{
+    const uint64_t limbs[2] = { uint64_t(value), uint64_t(value>>64) };
+    return u128tocstrCStyle(limbs, str, maxSize, radix, width, prefix);
+}
+#endif
 
 /// format half float in C-style
 /** format to string the half float in C-style formatting. This function handles 2 modes
@@ -285,6 +752,765 @@ extern size_t ftocstrCStyle(float value, char* str, size_t maxSize,
 extern size_t dtocstrCStyle(double value, char* str, size_t maxSize,
                             bool scientific = false);
 
+/// format half float in C-style (shortest form)
+/** format to string the half float in C-style formatting. Prints shortest number of
+ * digits that parsed gives this same value (if many then nearest to value is choosen).
+ * This function handles 2 modes of printing value: human readable and scientific.
+ * Currently only IEEE-754 format is supported.
+ * \param value float value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param scientific enable scientific mode
+ * \return length of output string (excluding null-character)
+ */
+extern size_t htocstrShortestCStyle(cxushort value, char* str, size_t maxSize,
+                            bool scientific = false);
+
+/// format single float in C-style (shortest form)
+/** format to string the single float in C-style formatting. Prints shortest number of
+ * digits that parsed gives this same value (if many then nearest to value is choosen).
+ * This function handles 2 modes of printing value: human readable and scientific.
+ * Currently only IEEE-754 format is supported.
+ * \param value float value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param scientific enable scientific mode
+ * \return length of output string (excluding null-character)
+ */
+extern size_t ftocstrShortestCStyle(float value, char* str, size_t maxSize,
+                            bool scientific = false);
+
+/// format double float in C-style (shortest form)
+/** format to string the double float in C-style formatting. Prints shortest number of
+ * digits that parsed gives this same value (if many then nearest to value is choosen).
+ * This function handles 2 modes of printing value: human readable and scientific.
+ * Currently only IEEE-754 format is supported.
+ * \param value float value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param scientific enable scientific mode
+ * \return length of output string (excluding null-character)
+ */
+extern size_t dtocstrShortestCStyle(double value, char* str, size_t maxSize,
+                            bool scientific = false);
+
+/// precision for fixed formatting that prints all digits of exact value
+const cxuint FXTOCSTR_EXACT_PRECISION = UINT_MAX;
+
+/// format half float in C-style with fixed precision
+/** format to string the half float with fixed precision like printf with '%.Nf'
+ * or '%.Ne' (scientific mode). Result is correctly rounded (to nearest even) for any
+ * precision. If precision is FXTOCSTR_EXACT_PRECISION then all digits of
+ * exact value are printed.
+ * Currently only IEEE-754 format is supported.
+ * \param value float value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param precision number of digits after decimal point
+ * \param scientific enable scientific mode
+ * \return length of output string (excluding null-character)
+ */
+extern size_t htocstrFixedCStyle(cxushort value, char* str, size_t maxSize,
+                cxuint precision, bool scientific = false);
+
+/// format single float in C-style with fixed precision
+/** format to string the single float with fixed precision like printf with '%.Nf'
+ * or '%.Ne' (scientific mode). Result is correctly rounded (to nearest even) for any
+ * precision. If precision is FXTOCSTR_EXACT_PRECISION then all digits of
+ * exact value are printed.
+ * Currently only IEEE-754 format is supported.
+ * \param value float value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param precision number of digits after decimal point
+ * \param scientific enable scientific mode
+ * \return length of output string (excluding null-character)
+ */
+extern size_t ftocstrFixedCStyle(float value, char* str, size_t maxSize,
+                cxuint precision, bool scientific = false);
+
+/// format double float in C-style with fixed precision
+/** format to string the double float with fixed precision like printf with '%.Nf'
+ * or '%.Ne' (scientific mode). Result is correctly rounded (to nearest even) for any
+ * precision. If precision is FXTOCSTR_EXACT_PRECISION then all digits of
+ * exact value are printed.
+ * Currently only IEEE-754 format is supported.
+ * \param value float value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param precision number of digits after decimal point
+ * \param scientific enable scientific mode
+ * \return length of output string (excluding null-character)
+ */
+extern size_t dtocstrFixedCStyle(double value, char* str, size_t maxSize,
+                cxuint precision, bool scientific = false);
+
+/// format half float in hexadecimal form
+/** format to string the half float in hexadecimal form like printf with '%a'
+ * (for example 0x1.8p+1). Output is exact and can be parsed back by cstrtohCStyle.
+ * Subnormal values are printed with leading zero and minimal exponent (0x0.004p-14).
+ * \param value float value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \return length of output string (excluding null-character)
+ */
+extern size_t htocstrHexCStyle(cxushort value, char* str, size_t maxSize);
+
+/// format single float in hexadecimal form
+/** format to string the single float in hexadecimal form like printf with '%a'
+ * (for example 0x1.99999ap-4). Output is exact and can be parsed back by cstrtofCStyle.
+ * Subnormal values are printed with leading zero and minimal exponent.
+ * \param value float value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \return length of output string (excluding null-character)
+ */
+extern size_t ftocstrHexCStyle(float value, char* str, size_t maxSize);
+
+/// format double float in hexadecimal form
+/** format to string the double float in hexadecimal form like printf with '%a'
+ * (for example 0x1.999999999999ap-4). Output is exact and can be parsed back
+ * by cstrtodCStyle. Subnormal values are printed with leading zero and minimal exponent.
+ * \param value float value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \return length of output string (excluding null-character)
+ */
+extern size_t dtocstrHexCStyle(double value, char* str, size_t maxSize);
+
+/*
+ * max lengths of formatted numbers and non-throwing formatting
+ */
+
+/// max length (excluding null-character) of htocstrCStyle output (any mode)
+constexpr size_t HTOCSTR_MAX_LENGTH = 11;
+/// max length (excluding null-character) of ftocstrCStyle output (any mode)
+constexpr size_t FTOCSTR_MAX_LENGTH = 16;
+/// max length (excluding null-character) of dtocstrCStyle output (any mode)
+constexpr size_t DTOCSTR_MAX_LENGTH = 25;
+/// max length (excluding null-character) of htocstrShortestCStyle output (any mode)
+constexpr size_t HTOCSTR_SHORTEST_MAX_LENGTH = 11;
+/// max length (excluding null-character) of ftocstrShortestCStyle output (any mode)
+constexpr size_t FTOCSTR_SHORTEST_MAX_LENGTH = 16;
+/// max length (excluding null-character) of dtocstrShortestCStyle output (any mode)
+constexpr size_t DTOCSTR_SHORTEST_MAX_LENGTH = 24;
+/// max length (excluding null-character) of htocstrHexCStyle output
+constexpr size_t HTOCSTR_HEX_MAX_LENGTH = 12;
+/// max length (excluding null-character) of ftocstrHexCStyle output
+constexpr size_t FTOCSTR_HEX_MAX_LENGTH = 16;
+/// max length (excluding null-character) of dtocstrHexCStyle output
+constexpr size_t DTOCSTR_HEX_MAX_LENGTH = 24;
+
+/// max number of digits of unsigned integer (bits - size of integer type)
+constexpr cxuint uXtocstrMaxDigitsNum(cxuint bits, cxuint radix)
+{
+    return (radix == 2) ? bits : (radix == 8) ? (bits+2)/3 : (radix == 16) ? (bits+3)>>2 :
+            ((bits*1233)>>12) + 1;
+}
+
+/// length of digitsNum digits with group separators (if UXTOCSTR_GROUP_DIGITS is set)
+constexpr size_t uXtocstrGroupedLength(size_t digitsNum, cxuint radix, cxuint flags)
+{
+    return ((flags & UXTOCSTR_GROUP_DIGITS) == 0) ? digitsNum :
+            digitsNum + (digitsNum-1) / ((radix == 2 || radix == 16) ? 4 : 3);
+}
+
+/// max length (excluding null-character) of unsigned integer output
+/** \param bits size of integer type in bits
+ * \param radix radix of digits (2, 8, 10, 16)
+ * \param width max number of digits in number
+ * \param prefix adds required prefix if true
+ * \param flags UXTOCSTR_UPPERCASE and UXTOCSTR_GROUP_DIGITS flags
+ * \return max length or zero if radix is unknown
+ */
+constexpr size_t uXtocstrMaxLength(cxuint bits, cxuint radix, cxuint width, bool prefix,
+            cxuint flags)
+{
+    return (radix != 2 && radix != 8 && radix != 10 && radix != 16) ? 0 :
+        ((!prefix || radix == 10) ? 0 : (radix == 8) ? 1 : 2) + ((radix == 10) ?
+        // decimal number is filled by spaces
+        ((width > uXtocstrGroupedLength(uXtocstrMaxDigitsNum(bits, 10), 10, flags)) ?
+            width : uXtocstrGroupedLength(uXtocstrMaxDigitsNum(bits, 10), 10, flags)) :
+        // other numbers are filled by zeroes (grouped too)
+        uXtocstrGroupedLength((width > uXtocstrMaxDigitsNum(bits, radix)) ?
+            width : uXtocstrMaxDigitsNum(bits, radix), radix, flags));
+}
+
+/// max length (excluding null-character) of u32tocstrCStyle output
+constexpr size_t u32tocstrMaxLength(cxuint radix = 10, cxuint width = 0,
+            bool prefix = true, cxuint flags = 0)
+{ return uXtocstrMaxLength(32, radix, width, prefix, flags); }
+
+/// max length (excluding null-character) of u64tocstrCStyle output
+constexpr size_t u64tocstrMaxLength(cxuint radix = 10, cxuint width = 0,
+            bool prefix = true, cxuint flags = 0)
+{ return uXtocstrMaxLength(64, radix, width, prefix, flags); }
+
+/// max length (excluding null-character) of u128tocstrCStyle output
+constexpr size_t u128tocstrMaxLength(cxuint radix = 10, cxuint width = 0,
+            bool prefix = true)
+{ return uXtocstrMaxLength(128, radix, width, prefix, 0); }
+
+/// max length of fixed precision output (intDigits - max digits of integer part,
+/// expDigits - max digits of exponent)
+constexpr size_t fXtocstrFixedMaxLength(cxuint precision, bool scientific,
+            cxuint intDigits, cxuint expDigits)
+{
+    return 1 + (scientific ? 1 + 2 + expDigits : intDigits) +
+            ((precision != 0) ? size_t(precision)+1 : 0);
+}
+
+/// max length (excluding null-character) of htocstrFixedCStyle output
+constexpr size_t htocstrFixedMaxLength(cxuint precision, bool scientific = false)
+{
+    return (precision == FXTOCSTR_EXACT_PRECISION) ? 27 :
+            fXtocstrFixedMaxLength(precision, scientific, 5, 2);
+}
+
+/// max length (excluding null-character) of ftocstrFixedCStyle output
+constexpr size_t ftocstrFixedMaxLength(cxuint precision, bool scientific = false)
+{
+    return (precision == FXTOCSTR_EXACT_PRECISION) ? (scientific ? 118 : 152) :
+            fXtocstrFixedMaxLength(precision, scientific, 39, 2);
+}
+
+/// max length (excluding null-character) of dtocstrFixedCStyle output
+constexpr size_t dtocstrFixedMaxLength(cxuint precision, bool scientific = false)
+{
+    return (precision == FXTOCSTR_EXACT_PRECISION) ? (scientific ? 774 : 1077) :
+            fXtocstrFixedMaxLength(precision, scientific, 309, 3);
+}
+
+/// format 32-bit unsigned integer without exceptions
+/** format 32-bit unsigned integer like u32tocstrCStyle, but never throws exception
+ * (like snprintf). If output does not fit into str then only empty string is written.
+ * If maxSize is zero, then nothing is written (str can be null) and function only
+ * measures output (cheaply, without formatting digits).
+ * \param value integer value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param radix radix of digits (2, 8, 10, 16)
+ * \param width max number of digits in number
+ * \param prefix adds required prefix if true
+ * \param flags UXTOCSTR_UPPERCASE and UXTOCSTR_GROUP_DIGITS flags
+ * \return length of whole output (excluding null-character) or zero if radix is unknown
+ */
+extern size_t u32tocstrNoThrowCStyle(uint32_t value, char* str, size_t maxSize,
+        cxuint radix = 10, cxuint width = 0, bool prefix = true, cxuint flags = 0) noexcept;
+
+/// format 64-bit unsigned integer without exceptions
+/** format 64-bit unsigned integer like u64tocstrCStyle, but never throws exception
+ * (like snprintf). If output does not fit into str then only empty string is written.
+ * If maxSize is zero, then nothing is written (str can be null) and function only
+ * measures output (cheaply, without formatting digits).
+ * \param value integer value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param radix radix of digits (2, 8, 10, 16)
+ * \param width max number of digits in number
+ * \param prefix adds required prefix if true
+ * \param flags UXTOCSTR_UPPERCASE and UXTOCSTR_GROUP_DIGITS flags
+ * \return length of whole output (excluding null-character) or zero if radix is unknown
+ */
+extern size_t u64tocstrNoThrowCStyle(uint64_t value, char* str, size_t maxSize,
+        cxuint radix = 10, cxuint width = 0, bool prefix = true, cxuint flags = 0) noexcept;
+
+/// format 128-bit unsigned integer without exceptions
+/** format 128-bit unsigned integer (two 64-bit limbs in little endian order) like
+ * u128tocstrCStyle, but never throws exception. If output does not fit into str then
+ * only empty string is written. If maxSize is zero, then nothing is written
+ * (str can be null).
+ * \param value integer value (two limbs)
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param radix radix of digits (2, 8, 10, 16)
+ * \param width max number of digits in number
+ * \param prefix adds required prefix if true
+ * \return length of whole output (excluding null-character) or zero if radix is unknown
+ */
+extern size_t u128tocstrNoThrowCStyle(const uint64_t* value, char* str, size_t maxSize,
+        cxuint radix = 10, cxuint width = 0, bool prefix = true) noexcept;
+
+/// format half float without exceptions
+/** format half float like htocstrCStyle (or htocstrShortestCStyle if shortest is set),
+ * but never throws exception. If output does not fit into str then only empty string
+ * is written. If maxSize is zero, then nothing is written (str can be null).
+ * \param value float value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param scientific enable scientific mode
+ * \param shortest print shortest form that can be parsed back to this same value
+ * \return length of whole output (excluding null-character)
+ */
+extern size_t htocstrNoThrowCStyle(cxushort value, char* str, size_t maxSize,
+        bool scientific = false, bool shortest = false) noexcept;
+
+/// format single float without exceptions
+/** format single float like ftocstrCStyle (or ftocstrShortestCStyle if shortest is set),
+ * but never throws exception. If output does not fit into str then only empty string
+ * is written. If maxSize is zero, then nothing is written (str can be null).
+ * \param value float value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param scientific enable scientific mode
+ * \param shortest print shortest form that can be parsed back to this same value
+ * \return length of whole output (excluding null-character)
+ */
+extern size_t ftocstrNoThrowCStyle(float value, char* str, size_t maxSize,
+        bool scientific = false, bool shortest = false) noexcept;
+
+/// format double float without exceptions
+/** format double float like dtocstrCStyle (or dtocstrShortestCStyle if shortest is set),
+ * but never throws exception. If output does not fit into str then only empty string
+ * is written. If maxSize is zero, then nothing is written (str can be null).
+ * \param value float value
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param scientific enable scientific mode
+ * \param shortest print shortest form that can be parsed back to this same value
+ * \return length of whole output (excluding null-character)
+ */
+extern size_t dtocstrNoThrowCStyle(double value, char* str, size_t maxSize,
+        bool scientific = false, bool shortest = false) noexcept;
+
+/// format half float in hexadecimal form without exceptions
+/** works like htocstrHexCStyle, but never throws exception. If output does not fit
+ * into str then only empty string is written. If maxSize is zero, then nothing is
+ * written (str can be null).
+ * \return length of whole output (excluding null-character)
+ */
+extern size_t htocstrHexNoThrowCStyle(cxushort value, char* str, size_t maxSize) noexcept;
+
+/// format single float in hexadecimal form without exceptions
+/** works like ftocstrHexCStyle, but never throws exception. If output does not fit
+ * into str then only empty string is written. If maxSize is zero, then nothing is
+ * written (str can be null).
+ * \return length of whole output (excluding null-character)
+ */
+extern size_t ftocstrHexNoThrowCStyle(float value, char* str, size_t maxSize) noexcept;
+
+/// format double float in hexadecimal form without exceptions
+/** works like dtocstrHexCStyle, but never throws exception. If output does not fit
+ * into str then only empty string is written. If maxSize is zero, then nothing is
+ * written (str can be null).
+ * \return length of whole output (excluding null-character)
+ */
+extern size_t dtocstrHexNoThrowCStyle(double value, char* str, size_t maxSize) noexcept;
+
+/// format half float with fixed precision without exceptions
+/** works like htocstrFixedCStyle, but never throws exception. If output does not fit
+ * into str then only empty string is written. If maxSize is zero, then nothing is
+ * written (str can be null). Output is measured cheaply, without formatting all digits.
+ * \return length of whole output (excluding null-character) or zero if memory
+ * allocation failed
+ */
+extern size_t htocstrFixedNoThrowCStyle(cxushort value, char* str, size_t maxSize,
+        cxuint precision, bool scientific = false) noexcept;
+
+/// format single float with fixed precision without exceptions
+/** works like ftocstrFixedCStyle, but never throws exception. If output does not fit
+ * into str then only empty string is written. If maxSize is zero, then nothing is
+ * written (str can be null). Output is measured cheaply, without formatting all digits.
+ * \return length of whole output (excluding null-character) or zero if memory
+ * allocation failed
+ */
+extern size_t ftocstrFixedNoThrowCStyle(float value, char* str, size_t maxSize,
+        cxuint precision, bool scientific = false) noexcept;
+
+/// format double float with fixed precision without exceptions
+/** works like dtocstrFixedCStyle, but never throws exception. If output does not fit
+ * into str then only empty string is written. If maxSize is zero, then nothing is
+ * written (str can be null). Output is measured cheaply, without formatting all digits.
+ * \return length of whole output (excluding null-character) or zero if memory
+ * allocation failed
+ */
+extern size_t dtocstrFixedNoThrowCStyle(double value, char* str, size_t maxSize,
+        cxuint precision, bool scientific = false) noexcept;
+
+/// format array of 32-bit unsigned integers
+/** format array of 32-bit unsigned integers (like u32tocstrCStyle) to single string.
+ * Elements are separated by separator. Function throws exception if output does not fit.
+ * \param n number of elements
+ * \param values array of elements
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param separator separator between elements
+ * \param offsets if not null, array of n offsets of elements in output string
+ * \param radix radix of digits (2, 8, 10, 16)
+ * \param width max number of digits in number
+ * \param prefix adds required prefix if true
+ * \param flags UXTOCSTR_UPPERCASE and UXTOCSTR_GROUP_DIGITS flags
+ * \return length of output string (excluding null-character)
+ */
+extern size_t u32tocstrArrayCStyle(size_t n, const uint32_t* values, char* str,
+        size_t maxSize, char separator = ' ', size_t* offsets = nullptr,
+        cxuint radix = 10, cxuint width = 0, bool prefix = true, cxuint flags = 0);
+
+/// format array of 64-bit unsigned integers
+/** format array of 64-bit unsigned integers (like u64tocstrCStyle) to single string.
+ * Elements are separated by separator. Function throws exception if output does not fit.
+ * \param n number of elements
+ * \param values array of elements
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param separator separator between elements
+ * \param offsets if not null, array of n offsets of elements in output string
+ * \param radix radix of digits (2, 8, 10, 16)
+ * \param width max number of digits in number
+ * \param prefix adds required prefix if true
+ * \param flags UXTOCSTR_UPPERCASE and UXTOCSTR_GROUP_DIGITS flags
+ * \return length of output string (excluding null-character)
+ */
+extern size_t u64tocstrArrayCStyle(size_t n, const uint64_t* values, char* str,
+        size_t maxSize, char separator = ' ', size_t* offsets = nullptr,
+        cxuint radix = 10, cxuint width = 0, bool prefix = true, cxuint flags = 0);
+
+/// format array of half floats
+/** format array of half floats (like htocstrCStyle or htocstrShortestCStyle) to
+ * single string. Elements are separated by separator. Function throws exception
+ * if output does not fit.
+ * \param n number of elements
+ * \param values array of elements
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param separator separator between elements
+ * \param offsets if not null, array of n offsets of elements in output string
+ * \param scientific enable scientific mode
+ * \param shortest print shortest form that can be parsed back to this same value
+ * \return length of output string (excluding null-character)
+ */
+extern size_t htocstrArrayCStyle(size_t n, const cxushort* values, char* str,
+        size_t maxSize, char separator = ' ', size_t* offsets = nullptr,
+        bool scientific = false, bool shortest = false);
+
+/// format array of single floats
+/** format array of single floats (like ftocstrCStyle or ftocstrShortestCStyle) to
+ * single string. Elements are separated by separator. Function throws exception
+ * if output does not fit.
+ * \param n number of elements
+ * \param values array of elements
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param separator separator between elements
+ * \param offsets if not null, array of n offsets of elements in output string
+ * \param scientific enable scientific mode
+ * \param shortest print shortest form that can be parsed back to this same value
+ * \return length of output string (excluding null-character)
+ */
+extern size_t ftocstrArrayCStyle(size_t n, const float* values, char* str,
+        size_t maxSize, char separator = ' ', size_t* offsets = nullptr,
+        bool scientific = false, bool shortest = false);
+
+/// format array of double floats
+/** format array of double floats (like dtocstrCStyle or dtocstrShortestCStyle) to
+ * single string. Elements are separated by separator. Function throws exception
+ * if output does not fit.
+ * \param n number of elements
+ * \param values array of elements
+ * \param str output string
+ * \param maxSize max size of string (including null-character)
+ * \param separator separator between elements
+ * \param offsets if not null, array of n offsets of elements in output string
+ * \param scientific enable scientific mode
+ * \param shortest print shortest form that can be parsed back to this same value
+ * \return length of output string (excluding null-character)
+ */
+extern size_t dtocstrArrayCStyle(size_t n, const double* values, char* str,
+        size_t maxSize, char separator = ' ', size_t* offsets = nullptr,
+        bool scientific = false, bool shortest = false);
+
+/// format array of 32-bit unsigned integers in parallel
+/** works like u32tocstrArrayCStyle, but output is formatted
+ * in two passes by threadsNum threads: first pass computes lengths of parts of array,
+ * second pass formats parts at their offsets (computed by prefix sum). If output
+ * does not fit, then exception is thrown before writing (to string and offsets).
+ * \param threadsNum number of threads (0 - number of hardware threads)
+ * \return length of output string (excluding null-character)
+ */
+extern size_t u32tocstrArrayParallelCStyle(size_t n, const uint32_t* values, char* str,
+        size_t maxSize, char separator = ' ', size_t* offsets = nullptr,
+        cxuint radix = 10, cxuint width = 0, bool prefix = true, cxuint flags = 0,
+        cxuint threadsNum = 0);
+
+/// format array of 64-bit unsigned integers in parallel
+/** works like u64tocstrArrayCStyle, but output is formatted
+ * in two passes by threadsNum threads: first pass computes lengths of parts of array,
+ * second pass formats parts at their offsets (computed by prefix sum). If output
+ * does not fit, then exception is thrown before writing (to string and offsets).
+ * \param threadsNum number of threads (0 - number of hardware threads)
+ * \return length of output string (excluding null-character)
+ */
+extern size_t u64tocstrArrayParallelCStyle(size_t n, const uint64_t* values, char* str,
+        size_t maxSize, char separator = ' ', size_t* offsets = nullptr,
+        cxuint radix = 10, cxuint width = 0, bool prefix = true, cxuint flags = 0,
+        cxuint threadsNum = 0);
+
+/// format array of half floats in parallel
+/** works like htocstrArrayCStyle, but output is formatted
+ * in two passes by threadsNum threads: first pass measures parts of array (elements are
+ * formatted to small stack buffer), second pass formats parts at their offsets
+ * (computed by prefix sum). If output does not fit, then exception is thrown before
+ * writing (to string and offsets).
+ * \param threadsNum number of threads (0 - number of hardware threads)
+ * \return length of output string (excluding null-character)
+ */
+extern size_t htocstrArrayParallelCStyle(size_t n, const cxushort* values, char* str,
+        size_t maxSize, char separator = ' ', size_t* offsets = nullptr,
+        bool scientific = false, bool shortest = false, cxuint threadsNum = 0);
+
+/// format array of single floats in parallel
+/** works like ftocstrArrayCStyle, but output is formatted
+ * in two passes by threadsNum threads: first pass measures parts of array (elements are
+ * formatted to small stack buffer), second pass formats parts at their offsets
+ * (computed by prefix sum). If output does not fit, then exception is thrown before
+ * writing (to string and offsets).
+ * \param threadsNum number of threads (0 - number of hardware threads)
+ * \return length of output string (excluding null-character)
+ */
+extern size_t ftocstrArrayParallelCStyle(size_t n, const float* values, char* str,
+        size_t maxSize, char separator = ' ', size_t* offsets = nullptr,
+        bool scientific = false, bool shortest = false, cxuint threadsNum = 0);
+
+/// format array of double floats in parallel
+/** works like dtocstrArrayCStyle, but output is formatted
+ * in two passes by threadsNum threads: first pass measures parts of array (elements are
+ * formatted to small stack buffer), second pass formats parts at their offsets
+ * (computed by prefix sum). If output does not fit, then exception is thrown before
+ * writing (to string and offsets).
+ * \param threadsNum number of threads (0 - number of hardware threads)
+ * \return length of output string (excluding null-character)
+ */
+extern size_t dtocstrArrayParallelCStyle(size_t n, const double* values, char* str,
+        size_t maxSize, char separator = ' ', size_t* offsets = nullptr,
+        bool scientific = false, bool shortest = false, cxuint threadsNum = 0);
+
+/// statistics of cache of big powers of 5
+struct BigPow5CacheStats
+{
+    uint64_t hits;      ///< number of cache hits
+    uint64_t misses;    ///< number of cache misses (including not cached powers)
+    size_t entries;     ///< number of filled entries
+    size_t usedLimbs;   ///< number of used 64-bit limbs in cache pool
+};
+
+/// get statistics of process-wide cache of big powers of 5
+/** cache is used by the slow paths of floating point parsing and formatting,
+ * powers that can be taken from builtin table are not counted.
+ * \return cache statistics
+ */
+extern BigPow5CacheStats getBigPow5CacheStats();
+
+/*
+ * big unsigned integers
+ */
+
+/// add big unsigned integers (biga += bigb)
+/** numbers are stored in little endian order of 64-bit limbs.
+ * \param aSize size of biga in 64-bit limbs
+ * \param biga first number and result
+ * \param bSize size of bigb in 64-bit limbs (must not be greater than aSize)
+ * \param bigb second number
+ * \return carry
+ */
+extern bool bigUIntAdd(cxuint aSize, uint64_t* biga, cxuint bSize, const uint64_t* bigb);
+
+/// subtract big unsigned integers (biga -= bigb)
+/** numbers are stored in little endian order of 64-bit limbs.
+ * \param aSize size of biga in 64-bit limbs
+ * \param biga first number and result
+ * \param bSize size of bigb in 64-bit limbs (must not be greater than aSize)
+ * \param bigb second number
+ * \return borrow
+ */
+extern bool bigUIntSub(cxuint aSize, uint64_t* biga, cxuint bSize, const uint64_t* bigb);
+
+/// multiply big unsigned integers (bigc = biga*bigb)
+/** numbers are stored in little endian order of 64-bit limbs. Uses Karatsuba algorithm
+ * for big numbers and unrolled kernels for small numbers.
+ * \param aSize size of biga in 64-bit limbs
+ * \param biga first number
+ * \param bSize size of bigb in 64-bit limbs
+ * \param bigb second number
+ * \param bigc result (aSize+bSize limbs), must not overlap biga or bigb
+ */
+extern void bigUIntMul(cxuint aSize, const uint64_t* biga, cxuint bSize,
+            const uint64_t* bigb, uint64_t* bigc);
+
+/// shift right big unsigned integer
+/**
+ * \param size size of number in 64-bit limbs
+ * \param bigNum number
+ * \param shift shift in bits
+ */
+extern void bigUIntShiftRight(cxuint size, uint64_t* bigNum, cxuint shift);
+
+/// shift left big unsigned integer (bits shifted out are lost)
+/**
+ * \param size size of number in 64-bit limbs
+ * \param bigNum number
+ * \param shift shift in bits
+ */
+extern void bigUIntShiftLeft(cxuint size, uint64_t* bigNum, cxuint shift);
+
+/// round big unsigned integer to nearest by removing lowest limbs
+/** result is stored in first outSize limbs of bigNum.
+ * \param inSize input size of number in 64-bit limbs
+ * \param outSize output size of number in 64-bit limbs (must be smaller than inSize)
+ * \param bigNum number
+ * \return carry (if true then result is 2**(outSize*64))
+ */
+extern bool bigUIntRoundToNearest(cxuint inSize, cxuint outSize, uint64_t* bigNum);
+
+/// compare big unsigned integers
+/**
+ * \param size size of numbers in 64-bit limbs
+ * \param biga first number
+ * \param bigb second number
+ * \return -1 if biga<bigb, 0 if biga==bigb, 1 if biga>bigb
+ */
+extern cxint bigUIntCompare(cxuint size, const uint64_t* biga, const uint64_t* bigb);
+
+/// big unsigned integer with fixed capacity
+/** number holds N 64-bit limbs in inline storage (no heap allocation), operations
+ * are performed modulo 2**(N*64) like for native unsigned integers.
+ * Temporary products are allocated on stack.
+ */
+template<cxuint N>
+class BigUInt
+{
+private:
+    uint64_t limbs[N];  // little endian
+public:
+    /// constructor (zero)
+    BigUInt()
+    { std::fill(limbs, limbs+N, uint64_t(0)); }
+    /// constructor from 64-bit value
+    BigUInt(uint64_t value)
+    {
+        limbs[0] = value;
+        std::fill(limbs+1, limbs+N, uint64_t(0));
+    }
+    /// constructor from limbs (in little endian order)
+    BigUInt(cxuint size, const uint64_t* inLimbs)
+    {
+        const cxuint toCopy = std::min(size, N);
+        std::copy(inLimbs, inLimbs+toCopy, limbs);
+        std::fill(limbs+toCopy, limbs+N, uint64_t(0));
+    }
+    /// conversion from number with other capacity (truncates or extends)
+    template<cxuint M>
+    explicit BigUInt(const BigUInt<M>& b)
+    {
+        const cxuint toCopy = std::min(M, N);
+        std::copy(b.data(), b.data()+toCopy, limbs);
+        std::fill(limbs+toCopy, limbs+N, uint64_t(0));
+    }
+    BigUInt(const BigUInt&) = default;
+    BigUInt(BigUInt&&) = default;
+    BigUInt& operator=(const BigUInt&) = default;
+    BigUInt& operator=(BigUInt&&) = default;
+    
+    /// get number of limbs
+    static cxuint limbsNum()
+    { return N; }
+    /// get limbs
+    uint64_t* data()
+    { return limbs; }
+    /// get limbs
+    const uint64_t* data() const
+    { return limbs; }
+    /// get limb
+    uint64_t& operator[](cxuint i)
+    { return limbs[i]; }
+    /// get limb
+    const uint64_t& operator[](cxuint i) const
+    { return limbs[i]; }
+    
+    /// return true if zero
+    bool isZero() const
+    {
+        for (cxuint i = 0; i < N; i++)
+            if (limbs[i] != 0)
+                return false;
+        return true;
+    }
+    /// get number of significant bits
+    cxuint bitLength() const
+    {
+        for (cxuint i = N; i > 0; i--)
+            if (limbs[i-1] != 0)
+                return (i<<6) - CLZ64(limbs[i-1]);
+        return 0;
+    }
+    
+    /// add number, returns carry
+    bool addWithCarry(const BigUInt& b)
+    { return bigUIntAdd(N, limbs, N, b.limbs); }
+    /// subtract number, returns borrow
+    bool subWithBorrow(const BigUInt& b)
+    { return bigUIntSub(N, limbs, N, b.limbs); }
+    /// full product (without truncation)
+    template<cxuint M>
+    BigUInt<N+M> mulFull(const BigUInt<M>& b) const
+    {
+        BigUInt<N+M> out;
+        bigUIntMul(N, limbs, M, b.data(), out.data());
+        return out;
+    }
+    
+    BigUInt& operator+=(const BigUInt& b)
+    {
+        bigUIntAdd(N, limbs, N, b.limbs);
+        return *this;
+    }
+    BigUInt& operator-=(const BigUInt& b)
+    {
+        bigUIntSub(N, limbs, N, b.limbs);
+        return *this;
+    }
+    BigUInt& operator*=(const BigUInt& b)
+    {
+        uint64_t product[N<<1];
+        bigUIntMul(N, limbs, N, b.limbs, product);
+        std::copy(product, product+N, limbs);
+        return *this;
+    }
+    BigUInt& operator<<=(cxuint shift)
+    {
+        bigUIntShiftLeft(N, limbs, shift);
+        return *this;
+    }
+    BigUInt& operator>>=(cxuint shift)
+    {
+        bigUIntShiftRight(N, limbs, shift);
+        return *this;
+    }
+    
+    BigUInt operator+(const BigUInt& b) const
+    { return BigUInt(*this) += b; }
+    BigUInt operator-(const BigUInt& b) const
+    { return BigUInt(*this) -= b; }
+    BigUInt operator*(const BigUInt& b) const
+    { return BigUInt(*this) *= b; }
+    BigUInt operator<<(cxuint shift) const
+    { return BigUInt(*this) <<= shift; }
+    BigUInt operator>>(cxuint shift) const
+    { return BigUInt(*this) >>= shift; }
+    
+    bool operator==(const BigUInt& b) const
+    { return bigUIntCompare(N, limbs, b.limbs) == 0; }
+    bool operator!=(const BigUInt& b) const
+    { return bigUIntCompare(N, limbs, b.limbs) != 0; }
+    bool operator<(const BigUInt& b) const
+    { return bigUIntCompare(N, limbs, b.limbs) < 0; }
+    bool operator<=(const BigUInt& b) const
+    { return bigUIntCompare(N, limbs, b.limbs) <= 0; }
+    bool operator>(const BigUInt& b) const
+    { return bigUIntCompare(N, limbs, b.limbs) > 0; }
+    bool operator>=(const BigUInt& b) const
+    { return bigUIntCompare(N, limbs, b.limbs) >= 0; }
+};
+
 };
 
 #endif
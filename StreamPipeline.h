@@ -0,0 +1,253 @@
+/*
+ *  NumStringConv - number from/to string conversion utilities
+ *  Copyright (C) 2014 Mateusz Szpakowski
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+/*! \file StreamPipeline.h
+ * \brief streaming pipeline of parse tools (reader, workers, ordered writer)
+ */
+
+#ifndef __STREAMPIPELINE_H__
+#define __STREAMPIPELINE_H__
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <deque>
+#include <map>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <unistd.h>
+#include <NumStringConv.h>
+
+namespace CLRX
+{
+
+/// initial size of buffer of stream pipeline
+const size_t STREAM_BUFFER_SIZE = 4U<<20;
+
+/// chunk of stream (complete lines)
+struct StreamChunk
+{
+    size_t index;       ///< index of chunk in stream
+    std::vector<char> data; ///< buffer of input
+    size_t size;        ///< size of complete lines in buffer
+    size_t linesNum;    ///< number of processed lines
+    std::vector<char> output;   ///< output of processing
+    std::vector<CStrArrayParseError> errors;    ///< errors (index is line in chunk)
+};
+
+inline void streamWriteAll(int fd, const char* data, size_t size)
+{
+    while (size != 0)
+    {
+        const ssize_t written = ::write(fd, data, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw Exception(std::string("Cant write output: ") + ::strerror(errno));
+        }
+        data += written;
+        size -= written;
+    }
+}
+
+/// process lines of stream in pipeline
+/** reader thread fills big buffers with complete lines (only partial last line is
+ * copied to next buffer), worker threads process buffers by
+ * processLines(begin, end, pool, output, errors) that returns number of lines
+ * and writer (calling thread) writes outputs and prints errors in input order.
+ * \return number of errors
+ */
+template<typename ProcessLines>
+static size_t processStreamLines(int inFd, int outFd, cxuint workersNum,
+            ProcessLines processLines)
+{
+    if (workersNum == 0)
+        workersNum = std::max(1U, std::thread::hardware_concurrency());
+    const size_t maxChunks = size_t(workersNum)*2 + 2;
+    // using vector for prevents memory leaks (function can throw exception)
+    std::vector<StreamChunk> chunks(maxChunks);
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<StreamChunk*> freeChunks;
+    std::deque<StreamChunk*> readyChunks; // chunks to process
+    std::map<size_t, StreamChunk*> doneChunks;
+    size_t chunksNum = 0;
+    bool readEnd = false;
+    bool stopping = false;
+    std::exception_ptr error;
+    for (StreamChunk& chunk: chunks)
+        freeChunks.push_back(&chunk);
+
+    auto fail = [&]()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+            error = std::current_exception();
+        stopping = true;
+        cond.notify_all();
+    };
+
+    auto reader = [&]()
+    {
+        try
+        {
+            std::vector<char> carry; // partial last line of previous buffer
+            bool eof = false;
+            while (!eof)
+            {
+                StreamChunk* chunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cond.wait(lock, [&] { return stopping || !freeChunks.empty(); });
+                    if (stopping)
+                        return;
+                    chunk = freeChunks.front();
+                    freeChunks.pop_front();
+                }
+                std::vector<char>& data = chunk->data;
+                if (data.size() < std::max(STREAM_BUFFER_SIZE, carry.size()*2))
+                    data.resize(std::max(STREAM_BUFFER_SIZE, carry.size()*2));
+                std::copy(carry.begin(), carry.end(), data.begin());
+                size_t size = carry.size();
+                const char* lastLineEnd = nullptr;
+                while (true)
+                {
+                    if (size == data.size())
+                    {   // buffer is full
+                        lastLineEnd = (const char*)::memrchr(data.data(), '\n', size);
+                        if (lastLineEnd != nullptr)
+                            break;
+                        data.resize(data.size()*2); // line longer than buffer
+                    }
+                    const ssize_t readSize = ::read(inFd, data.data()+size,
+                                data.size()-size);
+                    if (readSize < 0)
+                    {
+                        if (errno == EINTR)
+                            continue;
+                        throw Exception(std::string("Cant read input: ") +
+                                ::strerror(errno));
+                    }
+                    if (readSize == 0)
+                    {   // last line does not need newline
+                        eof = true;
+                        break;
+                    }
+                    size += readSize;
+                }
+                chunk->size = (eof) ? size : lastLineEnd+1 - data.data();
+                carry.assign(data.data()+chunk->size, data.data()+size);
+                std::lock_guard<std::mutex> lock(mutex);
+                chunk->index = chunksNum++;
+                readyChunks.push_back(chunk);
+                readEnd = eof;
+                cond.notify_all();
+            }
+        }
+        catch(...)
+        { fail(); }
+    };
+
+    auto worker = [&]()
+    {
+        try
+        {
+            ThreadPool pool(1);
+            while (true)
+            {
+                StreamChunk* chunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cond.wait(lock, [&]
+                        { return stopping || readEnd || !readyChunks.empty(); });
+                    if (stopping || readyChunks.empty())
+                        return;
+                    chunk = readyChunks.front();
+                    readyChunks.pop_front();
+                }
+                chunk->output.clear();
+                chunk->errors.clear();
+                chunk->linesNum = processLines(chunk->data.data(),
+                        chunk->data.data()+chunk->size, pool, chunk->output,
+                        chunk->errors);
+                std::lock_guard<std::mutex> lock(mutex);
+                doneChunks[chunk->index] = chunk;
+                cond.notify_all();
+            }
+        }
+        catch(...)
+        { fail(); }
+    };
+
+    std::vector<std::thread> threads;
+    size_t errorsNum = 0;
+    try
+    {
+        threads.push_back(std::thread(reader));
+        for (cxuint i = 0; i < workersNum; i++)
+            threads.push_back(std::thread(worker));
+
+        // ordered writer
+        size_t lineBase = 0;
+        for (size_t next = 0; ; next++)
+        {
+            StreamChunk* chunk;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&] { return stopping || doneChunks.count(next) != 0 ||
+                            (readEnd && next == chunksNum); });
+                if (stopping || doneChunks.count(next) == 0)
+                    break;
+                chunk = doneChunks[next];
+                doneChunks.erase(next);
+            }
+            streamWriteAll(outFd, chunk->output.data(), chunk->output.size());
+            for (const CStrArrayParseError& error: chunk->errors)
+            {
+                errorsNum++;
+                fprintf(stderr, "Line %zu: %s\n", lineBase + error.index + 1,
+                        error.message.c_str());
+            }
+            lineBase += chunk->linesNum;
+            std::lock_guard<std::mutex> lock(mutex);
+            freeChunks.push_back(chunk);
+            cond.notify_all();
+        }
+    }
+    catch(...)
+    { fail(); }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        cond.notify_all();
+    }
+    for (std::thread& thread: threads)
+        thread.join();
+    if (error)
+        std::rethrow_exception(error);
+    return errorsNum;
+}
+
+}
+
+#endif
@@ -0,0 +1,286 @@
+/*
+ *  NumStringConv - number from/to string conversion utilities
+ *  Copyright (C) 2014 Mateusz Szpakowski
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/* bulk converter: maps text file to memory, locates all numeric literals (C-style
+ * integers, decimal and hexadecimal floats), converts them in parallel and writes
+ * packed binary values to output file */
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <NumStringConv.h>
+
+using namespace CLRX;
+
+/* minimal size of chunk of input file */
+static const size_t MIN_CHUNK_SIZE = 1U<<20;
+/* max number of printed errors */
+static const size_t MAX_PRINTED_ERRORS = 10;
+
+static inline bool isLiteralChar(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+            c == '_' || c == '.' || c == '+' || c == '-';
+}
+
+static inline bool isDigit(char c)
+{ return c >= '0' && c <= '9'; }
+
+/* returns end of literal that begins at p. sign inside literal is allowed only after
+ * exponent character ('e' in decimal, 'p' in hexadecimal literal), otherwise it
+ * begins next literal (for example "1-2" or "2024-01-01") */
+static const char* findLiteralEnd(const char* p, const char* end)
+{
+    const char* q = (*p == '+' || *p == '-') ? p+1 : p;
+    const bool hexadecimal = (end-q >= 2 && q[0] == '0' && (q[1] == 'x' || q[1] == 'X'));
+    const char expChar = hexadecimal ? 'p' : 'e';
+    for (p = q; p != end && isLiteralChar(*p); p++)
+        if ((*p == '+' || *p == '-') && (p == q || (p[-1] | 0x20) != expChar))
+            break;
+    return p;
+}
+
+struct LiteralError
+{
+    size_t offset;
+    std::string message;
+};
+
+/* converted literals of chunk of input */
+template<typename T>
+struct ChunkResult
+{
+    std::vector<T> values;
+    std::vector<LiteralError> errors;
+};
+
+/* locate literals in chunk and convert them. literal is run of literal characters
+ * that begins with digit, dot or sign followed by digit or dot. value of
+ * incorrect literal is zero (values stay aligned with literals) */
+template<typename T, typename ParseElem>
+static void convertChunk(const char* data, const char* start, const char* end,
+            void (*parseFields)(size_t, const char* const*, const char* const*, T*),
+            ParseElem parseElem, ChunkResult<T>& result)
+{
+    std::vector<const char*> strs;
+    std::vector<const char*> inends;
+    for (const char* p = start; p != end;)
+    {
+        if (!isLiteralChar(*p))
+        {
+            p++;
+            continue;
+        }
+        const char* runEnd = findLiteralEnd(p, end);
+        const char* q = (*p == '+' || *p == '-') ? p+1 : p;
+        if (q != runEnd && (isDigit(*q) || (*q == '.' && q+1 != runEnd && isDigit(q[1]))))
+        {
+            strs.push_back(p);
+            inends.push_back(runEnd);
+        }
+        p = runEnd;
+    }
+    const size_t n = strs.size();
+    result.values.resize(n);
+    if (parseFields != nullptr)
+        try
+        {   // fast path: all literals are correct
+            parseFields(n, strs.data(), inends.data(), result.values.data());
+            return;
+        }
+        catch(const ParseException& ex)
+        { }
+    for (size_t i = 0; i < n; i++)
+        try
+        {
+            const char* outend;
+            result.values[i] = parseElem(strs[i], inends[i], outend);
+            if (outend != inends[i])
+                throw ParseException("Garbage at end of number");
+        }
+        catch(const ParseException& ex)
+        {
+            result.values[i] = T();
+            result.errors.push_back({ size_t(strs[i]-data), ex.what() });
+        }
+}
+
+static void writeAll(int fd, const char* data, size_t size)
+{
+    while (size != 0)
+    {
+        const ssize_t written = ::write(fd, data, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw Exception(std::string("Cant write output file: ") + ::strerror(errno));
+        }
+        data += written;
+        size -= written;
+    }
+}
+
+template<typename T, typename ParseElem>
+static void convertFile(const char* data, size_t size, int outFd, ThreadPool& pool,
+            void (*parseFields)(size_t, const char* const*, const char* const*, T*),
+            ParseElem parseElem, size_t& valuesNum, size_t& errorsNum)
+{
+    // split file at characters that does not belong to literals
+    const size_t chunksNum = std::max(size_t(1), std::min(size/MIN_CHUNK_SIZE,
+                size_t(pool.getThreadsNum())*8));
+    std::vector<const char*> chunkStarts(chunksNum+1);
+    chunkStarts[0] = data;
+    chunkStarts[chunksNum] = data+size;
+    for (size_t i = 1; i < chunksNum; i++)
+    {
+        const char* p = std::max(chunkStarts[i-1], data + size*i/chunksNum);
+        while (p != data+size && isLiteralChar(*p)) p++;
+        chunkStarts[i] = p;
+    }
+    std::vector<ChunkResult<T> > results(chunksNum);
+    pool.run(chunksNum, [&](size_t chunk)
+    {
+        convertChunk<T>(data, chunkStarts[chunk], chunkStarts[chunk+1], parseFields,
+                parseElem, results[chunk]);
+    });
+
+    valuesNum = 0;
+    errorsNum = 0;
+    for (const ChunkResult<T>& result: results)
+    {
+        writeAll(outFd, (const char*)result.values.data(), result.values.size()*sizeof(T));
+        for (const LiteralError& error: result.errors)
+            if (errorsNum++ < MAX_PRINTED_ERRORS)
+                fprintf(stderr, "Offset %zu: %s\n", error.offset, error.message.c_str());
+        valuesNum += result.values.size();
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    if (argc < 4)
+    {
+        puts("Usage: cstrtoXBulk input_file output_file h|f|d|i|l [threadsNum]");
+        return 0;
+    }
+
+    cxuint threadsNum = 0;
+    if (argc == 5)
+    {
+        char* endptr;
+        errno = 0;
+        threadsNum = strtoul(argv[4], &endptr, 10);
+        if (errno != 0 || *endptr != 0 || endptr == argv[4])
+        {
+            fputs("Cant parse threadsNum\n", stderr);
+            return 1;
+        }
+    }
+
+    int inFd = -1, outFd = -1;
+    void* data = MAP_FAILED;
+    size_t size = 0;
+    int retVal = 0;
+    try
+    {
+        const auto start = std::chrono::steady_clock::now();
+        inFd = ::open(argv[1], O_RDONLY);
+        if (inFd < 0)
+            throw Exception(std::string("Cant open input file: ") + ::strerror(errno));
+        struct stat stBuf;
+        if (::fstat(inFd, &stBuf) < 0)
+            throw Exception(std::string("Cant stat input file: ") + ::strerror(errno));
+        size = stBuf.st_size;
+        if (size != 0)
+        {
+            data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, inFd, 0);
+            if (data == MAP_FAILED)
+                throw Exception(std::string("Cant map input file: ") + ::strerror(errno));
+            ::madvise(data, size, MADV_SEQUENTIAL);
+        }
+        outFd = ::open(argv[2], O_WRONLY|O_CREAT|O_TRUNC, 0644);
+        if (outFd < 0)
+            throw Exception(std::string("Cant open output file: ") + ::strerror(errno));
+
+        ThreadPool pool(threadsNum);
+        const char* cdata = (const char*)data;
+        size_t valuesNum = 0, errorsNum = 0;
+        switch(argv[3][0])
+        {
+            case 'h':
+                convertFile<cxushort>(cdata, size, outFd, pool, nullptr, cstrtohCStyle,
+                        valuesNum, errorsNum);
+                break;
+            case 'f':
+                convertFile<float>(cdata, size, outFd, pool, cstrtofFieldsCStyle,
+                        cstrtofCStyle, valuesNum, errorsNum);
+                break;
+            case 'd':
+                convertFile<double>(cdata, size, outFd, pool, cstrtodFieldsCStyle,
+                        cstrtodCStyle, valuesNum, errorsNum);
+                break;
+            case 'i':
+                convertFile<uint32_t>(cdata, size, outFd, pool, cstrtou32FieldsCStyle,
+                        cstrtou32CStyle, valuesNum, errorsNum);
+                break;
+            case 'l':
+                convertFile<uint64_t>(cdata, size, outFd, pool, cstrtou64FieldsCStyle,
+                        cstrtou64CStyle, valuesNum, errorsNum);
+                break;
+            default:
+                throw Exception("Unknown type");
+                break;
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(end-start).count();
+        printf("Converted %zu numbers (%zu errors) from %zu bytes in %.3f s\n"
+               "Throughput: %.2f MB/s, %.0f numbers/s (%u threads)\n",
+               valuesNum, errorsNum, size, seconds, double(size)/(seconds*1e6),
+               double(valuesNum)/seconds, pool.getThreadsNum());
+        if (errorsNum != 0)
+            retVal = 1;
+    }
+    catch(const std::exception& ex)
+    {
+        fputs("Failed: ", stderr);
+        fputs(ex.what(), stderr);
+        fputs("\n", stderr);
+        retVal = 1;
+    }
+    if (data != MAP_FAILED)
+        ::munmap(data, size);
+    if (inFd >= 0)
+        ::close(inFd);
+    if (outFd >= 0 && ::close(outFd) < 0)
+    {
+        fputs("Cant close output file\n", stderr);
+        retVal = 1;
+    }
+    return retVal;
+}
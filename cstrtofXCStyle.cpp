@@ -22,9 +22,12 @@
 #include <cstring>
 #include <cerrno>
 #include <cstdint>
+#include <algorithm>
+#include <vector>
 #define __STDC_FORMAT_MACROS
 #include <cinttypes>
 #include <NumStringConv.h>
+#include <StreamPipeline.h>
 
 using namespace CLRX;
 
@@ -63,13 +66,95 @@ float halfToFloat(uint16_t halfVal)
     return v.f;
 }
 
+/* streaming mode: parses lines from standard input and writes bit patterns
+ * (one per line) or binary values to standard output */
+template<typename T, typename ParseArray>
+static int parseStream(bool binary, cxuint workersNum, ParseArray parseArray)
+{
+    const size_t errorsNum = processStreamLines(0, 1, workersNum,
+        [binary, parseArray](const char* begin, const char* end, ThreadPool& pool,
+            std::vector<char>& output, std::vector<CStrArrayParseError>& errors)
+        {
+            const size_t maxValuesNum = std::count(begin, end, '\n')+1;
+            std::vector<T> values(maxValuesNum);
+            const size_t n = parseArray(begin, end, maxValuesNum, values.data(),
+                        errors, pool, '\n');
+            if (binary)
+            {
+                output.assign((const char*)values.data(),
+                        (const char*)(values.data()+n));
+                return n;
+            }
+            const cxuint digitsNum = sizeof(T)*2;
+            output.resize(n*(digitsNum+1));
+            char* p = output.data();
+            for (size_t i = 0; i < n; i++)
+            {
+                uint64_t bits = 0;
+                ::memcpy(&bits, &values[i], sizeof(T));
+                p += u64tocstrCStyle(bits, p, digitsNum+1, 16, digitsNum, false);
+                *p++ = '\n';
+            }
+            return n;
+        });
+    return (errorsNum != 0) ? 1 : 0;
+}
+
+static int parseStreamMode(int argc, const char** argv)
+{
+    const bool binary = (argc >= 4 && argv[3][0] == 'b');
+    if (argc >= 4 && argv[3][0] != 'b' && argv[3][0] != 'x')
+    {
+        fputs("Unknown output mode\n", stderr);
+        return 1;
+    }
+    cxuint workersNum = 0;
+    if (argc >= 5)
+    {
+        char* endptr;
+        errno = 0;
+        workersNum = strtoul(argv[4], &endptr, 10);
+        if (errno != 0 || *endptr != 0 || endptr == argv[4])
+        {
+            fputs("Cant parse workersNum\n", stderr);
+            return 1;
+        }
+    }
+    try
+    {
+        switch(argv[2][0])
+        {
+            case 'h':
+                return parseStream<cxushort>(binary, workersNum,
+                        cstrtohArrayParallelCStyle);
+            case 'f':
+                return parseStream<float>(binary, workersNum, cstrtofArrayParallelCStyle);
+            case 'd':
+                return parseStream<double>(binary, workersNum, cstrtodArrayParallelCStyle);
+            default:
+                throw Exception("Unknown type");
+                break;
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        fputs("Failed: ",stderr);
+        fputs(ex.what(), stderr);
+        fputs("\n",stderr);
+    }
+    return 1;
+}
+
 int main(int argc, const char** argv)
 {
     if (argc < 3)
     {
-        puts("Usage: cstrtofXCStyle number_with_delim h|f|d [numchars]");
+        puts("Usage: cstrtofXCStyle number_with_delim h|f|d [numchars]\n"
+             "       cstrtofXCStyle - h|f|d [x|b] [workersNum]");
         return 0;
     }
+    if (::strcmp(argv[1], "-") == 0)
+        return parseStreamMode(argc, argv);
     
     size_t clen = 0;
     if (argc == 4)
@@ -22,6 +22,10 @@
 #include <sstream>
 #include <cstdint>
 #include <cstring>
+#include <algorithm>
+#include <vector>
+#include <thread>
+#include <atomic>
 #include <NumStringConv.h>
 
 using namespace CLRX;
@@ -1293,9 +1297,333 @@ static const CStrtofXTestCase cstrtofXTestCases[] =
             0x4c20000000000001ULL },
 };
 
+/* parse long literal repeatedly from many threads. exact midpoint requires
+ * big powers of 5 that are not in builtin tables (filled in cache) */
+static void testBigPow5Cache()
+{
+    // midpoint between 1e300 and next double
+    const char* midpoint =
+        "100000000000000012685560567909357338860759348860318716147886419848152541"
+        "077750116158340423310066654130212016864070140766687871274500908309837405"
+        "446203199237238991625604630709288637225616778178719368944494985764345704"
+        "090815653950118346208808667414690243420580625296099344037094217939202805"
+        "3726841274368";
+    const char* midpointEnd = midpoint + ::strlen(midpoint);
+    const char* nearest = "1.0000000000000001e300";
+    const char* outend;
+    const double expected = cstrtodCStyle(nearest, nearest+22, outend);
+    const BigPow5CacheStats before = getBigPow5CacheStats();
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> threads;
+    for (cxuint t = 0; t < 4; t++)
+        threads.push_back(std::thread([&]()
+        {
+            try
+            {
+                for (cxuint i = 0; i < 20; i++)
+                {
+                    const char* end;
+                    if (cstrtodCStyle(midpoint, midpointEnd, end) != expected ||
+                        end != midpointEnd)
+                        failed = true;
+                }
+            }
+            catch(...)
+            { failed = true; }
+        }));
+    for (std::thread& thread: threads)
+        thread.join();
+    const BigPow5CacheStats after = getBigPow5CacheStats();
+    if (failed)
+        throw Exception("Failed for long midpoint parsed by many threads");
+    if (after.hits <= before.hits || after.entries == 0 || after.usedLimbs == 0)
+        throw Exception("Failed for cache of big powers of 5");
+}
+
+/* feed incremental parsers by fragments of size 1, 2, 3... and compare with cstrtofXCStyle */
+static void testIncrParsers()
+{
+    std::string longInput = "1.00000005960464477539062";
+    longInput.append(2000, '0'); // beyond max kept digits
+    longInput += "1e0x";
+    const std::string inputs[8] = { "1.5e-3,", "-0x1.8p3 ", "nanx", "-.0e+5",
+        "3.40282356779733661637539395458142568447e38", "0x1.000001p0;",
+        longInput, "123456789012345678901234567890e-10" };
+    for (cxuint fragSize = 1; fragSize <= 4; fragSize++)
+        for (const std::string& input: inputs)
+        {
+            FloatIncrParser parser(8, 23);
+            const char* end = input.c_str()+input.size();
+            const char* p = input.c_str();
+            for (; p != end; p += fragSize)
+            {
+                const char* fragEnd = std::min(p+fragSize, end);
+                const char* numEnd = parser.feed(p, fragEnd);
+                if (parser.isFinished())
+                {
+                    p = numEnd;
+                    break;
+                }
+                if (fragEnd == end)
+                {
+                    p = end;
+                    break;
+                }
+            }
+            FloatUnion result;
+            result.u = parser.finish();
+            const char* outend;
+            const float expected = cstrtofCStyle(input.c_str(), end, outend);
+            if (::memcmp(&result.f, &expected, 4) != 0 || p != outend)
+                throw Exception("Failed for FloatIncrParser");
+        }
+    UIntIncrParser parser(32);
+    const char* input = "0x1f";
+    parser.feed(input, input+3);
+    if (parser.feed(input+3, input+4) != input+4 || parser.finish() != 31)
+        throw Exception("Failed for UIntIncrParser");
+    parser.reset();
+    bool failed = false;
+    try
+    {   // number out of range
+        const char* tooBig = "4294967296";
+        parser.feed(tooBig, tooBig+10);
+        parser.finish();
+        failed = true;
+    }
+    catch(const ParseException& ex)
+    { }
+    if (failed)
+        throw Exception("Failed for UIntIncrParser with too big number");
+}
+
+/* parse numbers from segmented strings and compare with parsing of whole string */
+static void testCStrtoSegments()
+{
+    const char* inputs[5][3] = {
+        { "1.25", "e2", "x" }, { "0x1.8", "", "p1 " }, { "-7.5 ", "1", "" },
+        { "1e", "", "-5" }, { "2.", "00000000000000000000000000000001", "000000001" }
+    };
+    for (cxuint i = 0; i < 5; i++)
+    {
+        std::string whole;
+        CStrSegment segments[3];
+        for (cxuint j = 0; j < 3; j++)
+        {
+            segments[j] = { inputs[i][j], inputs[i][j]+::strlen(inputs[i][j]) };
+            whole += inputs[i][j];
+        }
+        const char* outend;
+        const double expected = cstrtodCStyle(whole.c_str(),
+                      whole.c_str()+whole.size(), outend);
+        CStrSegmentPos outpos;
+        const double result = cstrtodSegmentsCStyle(3, segments, outpos);
+        size_t offset = outpos.ptr - segments[outpos.segment].str;
+        for (cxuint j = 0; j < outpos.segment; j++)
+            offset += ::strlen(inputs[i][j]);
+        if (::memcmp(&result, &expected, 8) != 0 || offset != size_t(outend-whole.c_str()))
+            throw Exception("Failed for cstrtodSegmentsCStyle");
+    }
+    const char* intInput1 = "0x1";
+    const char* intInput2 = "fffffffff,";
+    const CStrSegment intSegments[2] = { { intInput1, intInput1+3 },
+        { intInput2, intInput2+10 } };
+    CStrSegmentPos outpos;
+    if (cstrtou64SegmentsCStyle(2, intSegments, outpos) != 0x1fffffffffULL ||
+        outpos.segment != 1 || outpos.ptr != intSegments[1].str+9)
+        throw Exception("Failed for cstrtou64SegmentsCStyle");
+    bool failed = false;
+    try
+    {   // number out of range
+        cstrtou32SegmentsCStyle(2, intSegments, outpos);
+        failed = true;
+    }
+    catch(const ParseException& ex)
+    { }
+    if (failed)
+        throw Exception("Failed for cstrtou32SegmentsCStyle with too big number");
+}
+
+/* parse numbers from strings of wide characters */
+static void testCStrtoWide()
+{
+    const char16_t* input16 = u"-1.5e3\u0131";
+    const char16_t* end16;
+    if (cstrtodWideCStyle(input16, input16+7, end16) != -1500.0 || end16 != input16+6)
+        throw Exception("Failed for cstrtodWideCStyle<char16_t>");
+    // longer than block of narrowed characters
+    const char32_t* input32 = U"0.000000000000000000000000000000000000000000125\U00010031";
+    const char32_t* end32;
+    if (cstrtodWideCStyle(input32, input32+48, end32) != 1.25e-43 || end32 != input32+47)
+        throw Exception("Failed for cstrtodWideCStyle<char32_t>");
+    const wchar_t* inputW = L"0x1f\u0661";
+    const wchar_t* endW;
+    if (cstrtou32WideCStyle(inputW, inputW+5, endW) != 31 || endW != inputW+4)
+        throw Exception("Failed for cstrtou32WideCStyle<wchar_t>");
+    bool failed = false;
+    try
+    {   // non-ASCII digit is not a digit
+        cstrtofWideCStyle(input16+6, input16+7, end16);
+        failed = true;
+    }
+    catch(const ParseException& ex)
+    { }
+    if (failed)
+        throw Exception("Failed for cstrtofWideCStyle with non-ASCII character");
+}
+
+/* compare lane-parallel parsing with scalar parsing */
+static void testCStrtoFields()
+{
+    const char* inputs[11] = { "1.5", "-0", "12345678", "0x1p-3", "3.14159265358979",
+        "99999.99", "-0.0001", "inf", "7", "1e10", "16777217" };
+    const char* strs[11];
+    const char* inends[11];
+    for (cxuint i = 0; i < 11; i++)
+    {
+        strs[i] = inputs[i];
+        inends[i] = inputs[i] + ::strlen(inputs[i]);
+    }
+    double dvalues[11];
+    float fvalues[11];
+    cstrtodFieldsCStyle(11, strs, inends, dvalues);
+    cstrtofFieldsCStyle(11, strs, inends, fvalues);
+    for (cxuint i = 0; i < 11; i++)
+    {
+        const char* outend;
+        const double dexpected = cstrtodCStyle(strs[i], inends[i], outend);
+        const float fexpected = cstrtofCStyle(strs[i], inends[i], outend);
+        if (::memcmp(&dvalues[i], &dexpected, 8) != 0 ||
+            ::memcmp(&fvalues[i], &fexpected, 4) != 0)
+            throw Exception("Failed for cstrtodFields");
+    }
+    // integers (with octal and hexadecimal)
+    const char* istrs[6] = { "0", "017", "0x1f", "99999999", "4294967295", "12" };
+    const char* iinends[6];
+    for (cxuint i = 0; i < 6; i++)
+        iinends[i] = istrs[i] + ::strlen(istrs[i]);
+    uint64_t values64[6];
+    cstrtou64FieldsCStyle(6, istrs, iinends, values64);
+    if (values64[0] != 0 || values64[1] != 15 || values64[2] != 31 ||
+        values64[3] != 99999999 || values64[4] != 4294967295ULL || values64[5] != 12)
+        throw Exception("Failed for cstrtou64Fields");
+    bool failed = false;
+    try
+    {   // garbage at end of number
+        cstrtou64FieldsCStyle(1, strs, inends, values64);
+        failed = true;
+    }
+    catch(const ParseException& ex)
+    { }
+    if (failed)
+        throw Exception("Failed for cstrtou64Fields with garbage");
+}
+
+static void testCStrtodArrayParallel()
+{
+    ThreadPool pool(4);
+    // small input with errors
+    const char* input = " 1.5\n-2e3\nabc\n\n0x1p4 \n7x\n";
+    double values[6];
+    std::vector<CStrArrayParseError> errors;
+    if (cstrtodArrayParallelCStyle(input, input+::strlen(input), 6, values, errors,
+                pool) != 6 || values[0] != 1.5 || values[1] != -2e3 || values[2] != 0.0 ||
+        values[3] != 0.0 || values[4] != 16.0 || values[5] != 0.0 ||
+        errors.size() != 3 || errors[0].index != 2 || errors[0].offset != 10 ||
+        errors[1].index != 3 || errors[2].index != 5 ||
+        errors[2].message != "Garbage at end of number")
+        throw Exception("Failed for cstrtodArrayParallel");
+    // large input (split to many chunks), pool is reused
+    std::ostringstream oss;
+    const size_t n = 200000;
+    for (size_t i = 0; i < n; i++)
+        oss << (i*0.37) << ((i%7==0) ? " , " : ",");
+    const std::string bigInput = oss.str();
+    std::vector<double> bigValues(n);
+    if (cstrtodArrayParallelCStyle(bigInput.c_str(), bigInput.c_str()+bigInput.size(),
+                n, bigValues.data(), errors, pool, ',') != n || !errors.empty())
+        throw Exception("Failed for big cstrtodArrayParallel");
+    const char* p = bigInput.c_str();
+    for (size_t i = 0; i < n; i++)
+    {
+        while (*p == ' ') p++;
+        const char* outend;
+        const double expected = cstrtodCStyle(p, nullptr, outend);
+        if (::memcmp(&bigValues[i], &expected, 8) != 0)
+            throw Exception("Failed for big cstrtodArrayParallel at element");
+        p = ::strchr(outend, ',')+1;
+    }
+    uint32_t values32[2];
+    bool failed = false;
+    try
+    {   // too many numbers
+        cstrtou32ArrayParallelCStyle(input, input+::strlen(input), 2, values32, errors,
+                pool);
+        failed = true;
+    }
+    catch(const Exception& ex)
+    { }
+    if (failed)
+        throw Exception("Failed for cstrtou32ArrayParallel with too many numbers");
+}
+
 int main(int argc, const char** argv)
 {
     int retVal = 0;
+    try
+    {
+        testBigPow5Cache();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    try
+    {
+        testIncrParsers();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    try
+    {
+        testCStrtoSegments();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    try
+    {
+        testCStrtoWide();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    try
+    {
+        testCStrtoFields();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    try
+    {
+        testCStrtodArrayParallel();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
     for (cxuint i = 0; i < sizeof(cstrtofXTestCases)/sizeof(CStrtofXTestCase); i++)
         try
         {
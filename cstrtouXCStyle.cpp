@@ -22,17 +22,121 @@
 #include <cstring>
 #include <cerrno>
 #include <cstdint>
+#include <algorithm>
+#include <vector>
 #include <NumStringConv.h>
+#include <StreamPipeline.h>
 
 using namespace CLRX;
 
+/* streaming mode: parses lines from standard input and writes decimal values
+ * (one per line) or binary values to standard output */
+template<typename T, typename U, typename ParseArray>
+static int parseStream(bool binary, cxuint workersNum, ParseArray parseArray)
+{
+    const size_t errorsNum = processStreamLines(0, 1, workersNum,
+        [binary, parseArray](const char* begin, const char* end, ThreadPool& pool,
+            std::vector<char>& output, std::vector<CStrArrayParseError>& errors)
+        {
+            const size_t maxValuesNum = std::count(begin, end, '\n')+1;
+            std::vector<U> values(maxValuesNum);
+            const size_t n = parseArray(begin, end, maxValuesNum, values.data(),
+                        errors, pool, '\n');
+            if (sizeof(T) < sizeof(U))
+            {   // check range of smaller types
+                const size_t parseErrorsNum = errors.size();
+                for (size_t i = 0; i < n; i++)
+                    if (values[i] > U(T(-1)))
+                    {
+                        errors.push_back({ i, 0, "Number out of range" });
+                        values[i] = 0;
+                    }
+                std::inplace_merge(errors.begin(), errors.begin()+parseErrorsNum,
+                        errors.end(), [](const CStrArrayParseError& e1,
+                            const CStrArrayParseError& e2)
+                        { return e1.index < e2.index; });
+            }
+            if (binary)
+            {
+                output.resize(n*sizeof(T));
+                for (size_t i = 0; i < n; i++)
+                {
+                    const T value = values[i];
+                    ::memcpy(output.data() + i*sizeof(T), &value, sizeof(T));
+                }
+                return n;
+            }
+            output.resize(n*(u64tocstrMaxLength()+1));
+            char* p = output.data();
+            for (size_t i = 0; i < n; i++)
+            {
+                p += u64tocstrCStyle(values[i], p, u64tocstrMaxLength()+1);
+                *p++ = '\n';
+            }
+            output.resize(p - output.data());
+            return n;
+        });
+    return (errorsNum != 0) ? 1 : 0;
+}
+
+static int parseStreamMode(int argc, const char** argv)
+{
+    const bool binary = (argc >= 4 && argv[3][0] == 'b');
+    if (argc >= 4 && argv[3][0] != 'b' && argv[3][0] != 'd')
+    {
+        std::cerr << "Unknown output mode" << std::endl;
+        return 1;
+    }
+    cxuint workersNum = 0;
+    if (argc >= 5)
+    {
+        char* endptr;
+        errno = 0;
+        workersNum = strtoul(argv[4], &endptr, 10);
+        if (errno != 0 || *endptr != 0 || endptr == argv[4])
+        {
+            std::cerr << "Cant parse workersNum" << std::endl;
+            return 1;
+        }
+    }
+    try
+    {
+        switch(argv[2][0])
+        {
+            case 'b':
+                return parseStream<uint8_t, uint32_t>(binary, workersNum,
+                        cstrtou32ArrayParallelCStyle);
+            case 'h':
+                return parseStream<uint16_t, uint32_t>(binary, workersNum,
+                        cstrtou32ArrayParallelCStyle);
+            case 'i':
+                return parseStream<uint32_t, uint32_t>(binary, workersNum,
+                        cstrtou32ArrayParallelCStyle);
+            case 'l':
+                return parseStream<uint64_t, uint64_t>(binary, workersNum,
+                        cstrtou64ArrayParallelCStyle);
+            default:
+                throw Exception("Unknown type");
+                break;
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << "Failed: " << ex.what() << std::endl;
+    }
+    return 1;
+}
+
 int main(int argc, const char** argv)
 {
     if (argc < 3)
     {
-        std::cout << "Usage: cstrtouXCStyle number_with_delim b|h|i|l [numchars]" << std::endl;
+        std::cout << "Usage: cstrtouXCStyle number_with_delim b|h|i|l [numchars]\n"
+                "       cstrtouXCStyle - b|h|i|l [d|b] [workersNum]" << std::endl;
         return 0;
     }
+    if (::strcmp(argv[1], "-") == 0)
+        return parseStreamMode(argc, argv);
     
     size_t clen = 0;
     if (argc == 4)
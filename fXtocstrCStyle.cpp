@@ -25,6 +25,14 @@
 #include <climits>
 #include <cerrno>
 #include <cstdint>
+#include <vector>
+#include <string>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
 #define __STDC_FORMAT_MACROS
 #include <cinttypes>
 #include <NumStringConv.h>
@@ -66,11 +74,201 @@ float halfToFloat(uint16_t halfVal)
     return v.f;
 }
 
+/*
+ * binary-to-text bulk mode: formats all values from raw file (one value per line)
+ */
+
+/* number of values in chunk formatted by single thread */
+static const size_t BULK_CHUNK_VALUES = 1U<<16;
+
+enum BulkMode
+{
+    BULK_HUMAN_READABLE = 0,
+    BULK_SCIENTIFIC,
+    BULK_SHORTEST,
+    BULK_HEX
+};
+
+template<typename T, typename FormatArray, typename FormatHex>
+static size_t formatBulkChunk(const T* values, size_t n, BulkMode mode, char* out,
+            size_t maxSize, FormatArray formatArray, FormatHex formatHex)
+{
+    if (mode != BULK_HEX)
+    {
+        size_t length = formatArray(n, values, out, maxSize, '\n', nullptr,
+                    mode == BULK_SCIENTIFIC, mode == BULK_SHORTEST);
+        out[length++] = '\n';
+        return length;
+    }
+    size_t length = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        length += formatHex(values[i], out+length, maxSize-length);
+        out[length++] = '\n';
+    }
+    return length;
+}
+
+static void writevAll(int fd, struct iovec* iov, size_t iovNum)
+{
+    while (iovNum != 0)
+    {
+        ssize_t written = ::writev(fd, iov, std::min(iovNum, size_t(IOV_MAX)));
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw Exception(std::string("Cant write output: ") + ::strerror(errno));
+        }
+        // skip written buffers
+        for (; iovNum != 0 && size_t(written) >= iov->iov_len; iov++, iovNum--)
+            written -= iov->iov_len;
+        if (iovNum != 0)
+        {
+            iov->iov_base = (char*)iov->iov_base + written;
+            iov->iov_len -= written;
+        }
+    }
+}
+
+/* format values in batches of chunks: chunks of batch are formatted by thread pool
+ * to own buffers and written by single writev */
+template<typename T, typename FormatArray, typename FormatHex>
+static void formatBulk(const T* values, size_t valuesNum, BulkMode mode,
+            size_t maxLength, ThreadPool& pool, FormatArray formatArray,
+            FormatHex formatHex)
+{
+    const size_t chunksNum = (valuesNum + BULK_CHUNK_VALUES-1) / BULK_CHUNK_VALUES;
+    const size_t batchChunks = size_t(pool.getThreadsNum())*4;
+    const size_t chunkMaxSize = BULK_CHUNK_VALUES*(maxLength+1) + 1;
+    std::vector<std::vector<char> > buffers(std::min(chunksNum, batchChunks));
+    std::vector<struct iovec> iov(buffers.size());
+    for (size_t batch = 0; batch < chunksNum; batch += batchChunks)
+    {
+        const size_t curChunks = std::min(batchChunks, chunksNum-batch);
+        pool.run(curChunks, [&](size_t i)
+        {
+            const size_t first = (batch+i)*BULK_CHUNK_VALUES;
+            const size_t n = std::min(BULK_CHUNK_VALUES, valuesNum-first);
+            buffers[i].resize(chunkMaxSize);
+            iov[i].iov_base = buffers[i].data();
+            iov[i].iov_len = formatBulkChunk(values+first, n, mode, buffers[i].data(),
+                        chunkMaxSize, formatArray, formatHex);
+        });
+        writevAll(1, iov.data(), curChunks);
+    }
+}
+
+static int formatBinaryFile(int argc, const char** argv)
+{
+    if (argc < 4)
+    {
+        puts("Usage: fXtocstrCStyle -b raw_file h|f|d [r|e|s|x] [threadsNum]");
+        return 0;
+    }
+    BulkMode mode = BULK_HUMAN_READABLE;
+    if (argc >= 5)
+        switch(argv[4][0])
+        {
+            case 'r':
+                mode = BULK_HUMAN_READABLE;
+                break;
+            case 'e':
+                mode = BULK_SCIENTIFIC;
+                break;
+            case 's':
+                mode = BULK_SHORTEST;
+                break;
+            case 'x':
+                mode = BULK_HEX;
+                break;
+            default:
+                fputs("Unknown mode\n", stderr);
+                return 1;
+        }
+    cxuint threadsNum = 0;
+    if (argc >= 6)
+    {
+        char* endptr;
+        errno = 0;
+        threadsNum = strtoul(argv[5], &endptr, 10);
+        if (errno != 0 || *endptr != 0 || endptr == argv[5])
+        {
+            fputs("Cant parse threadsNum\n", stderr);
+            return 1;
+        }
+    }
+    
+    int fd = -1;
+    void* data = MAP_FAILED;
+    size_t size = 0;
+    int retVal = 0;
+    try
+    {
+        const cxuint elemSize = (argv[3][0] == 'h') ? 2 : (argv[3][0] == 'f') ? 4 :
+                (argv[3][0] == 'd') ? 8 : 0;
+        if (elemSize == 0)
+            throw Exception("Unknown type");
+        fd = ::open(argv[2], O_RDONLY);
+        if (fd < 0)
+            throw Exception(std::string("Cant open input file: ") + ::strerror(errno));
+        struct stat stBuf;
+        if (::fstat(fd, &stBuf) < 0)
+            throw Exception(std::string("Cant stat input file: ") + ::strerror(errno));
+        size = stBuf.st_size;
+        if ((size % elemSize) != 0)
+            throw Exception("Size of input file is not multiple of size of value");
+        if (size != 0)
+        {
+            data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+                throw Exception(std::string("Cant map input file: ") + ::strerror(errno));
+            ::madvise(data, size, MADV_SEQUENTIAL);
+        }
+        
+        ThreadPool pool(threadsNum);
+        const size_t valuesNum = size / elemSize;
+        switch(elemSize)
+        {
+            case 2:
+                formatBulk((const cxushort*)data, valuesNum, mode, (mode == BULK_HEX) ?
+                        HTOCSTR_HEX_MAX_LENGTH : HTOCSTR_MAX_LENGTH, pool,
+                        htocstrArrayCStyle, htocstrHexCStyle);
+                break;
+            case 4:
+                formatBulk((const float*)data, valuesNum, mode, (mode == BULK_HEX) ?
+                        FTOCSTR_HEX_MAX_LENGTH : FTOCSTR_MAX_LENGTH, pool,
+                        ftocstrArrayCStyle, ftocstrHexCStyle);
+                break;
+            default:
+                formatBulk((const double*)data, valuesNum, mode, (mode == BULK_HEX) ?
+                        DTOCSTR_HEX_MAX_LENGTH : DTOCSTR_MAX_LENGTH, pool,
+                        dtocstrArrayCStyle, dtocstrHexCStyle);
+                break;
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        fputs("Failed: ",stderr);
+        fputs(ex.what(), stderr);
+        fputs("\n",stderr);
+        retVal = 1;
+    }
+    if (data != MAP_FAILED)
+        ::munmap(data, size);
+    if (fd >= 0)
+        ::close(fd);
+    return retVal;
+}
+
 int main(int argc, const char** argv)
 {
+    if (argc >= 2 && ::strcmp(argv[1], "-b") == 0)
+        return formatBinaryFile(argc, argv);
     if (argc < 3)
     {
-        puts("Usage: fXtocstrCStyle number_with_delim h|f|d [maxSize]");
+        puts("Usage: fXtocstrCStyle number_with_delim h|f|d [maxSize]\n"
+             "       fXtocstrCStyle -b raw_file h|f|d [r|e|s|x] [threadsNum]");
         return 0;
     }
     
@@ -119,6 +317,16 @@ int main(int argc, const char** argv)
                     fputs("Failed SC htocstr: ",stdout);
                     puts(ex.what());
                 }
+                try
+                {
+                    outlen = htocstrHexCStyle(v, buffer, buflen);
+                    printf("HX htocstr: %s, %zu\n", buffer, outlen);
+                }
+                catch(const Exception& ex)
+                {
+                    fputs("Failed HX htocstr: ",stdout);
+                    puts(ex.what());
+                }
                 break;
             }
             case 'f':
@@ -147,6 +355,16 @@ int main(int argc, const char** argv)
                     fputs("Failed SC ftocstr: ",stdout);
                     puts(ex.what());
                 }
+                try
+                {
+                    outlen = ftocstrHexCStyle(v.f, buffer, buflen);
+                    printf("HX ftocstr: %s, %zu\n", buffer, outlen);
+                }
+                catch(const Exception& ex)
+                {
+                    fputs("Failed HX ftocstr: ",stdout);
+                    puts(ex.what());
+                }
                 break;
             }
             case 'd':
@@ -176,6 +394,16 @@ int main(int argc, const char** argv)
                     fputs("Failed SC dtocstr: ",stdout);
                     puts(ex.what());
                 }
+                try
+                {
+                    outlen = dtocstrHexCStyle(v.d, buffer, buflen);
+                    printf("HX dtocstr: %s, %zu\n", buffer, outlen);
+                }
+                catch(const Exception& ex)
+                {
+                    fputs("Failed HX dtocstr: ",stdout);
+                    puts(ex.what());
+                }
                 break;
             }
             default:
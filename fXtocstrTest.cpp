@@ -0,0 +1,488 @@
+/*
+ *  NumStringConv - number from/to string conversion utilities
+ *  Copyright (C) 2014 Mateusz Szpakowski
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <NumStringConv.h>
+
+using namespace CLRX;
+
+enum FloatType
+{
+    FT_H, FT_F, FT_D
+};
+
+union FloatUnion
+{
+    float f;
+    uint32_t u;
+};
+
+union DoubleUnion
+{
+    double d;
+    uint64_t u;
+};
+
+struct FXtocstrTestCase
+{
+    FloatType type;
+    uint64_t value;
+    bool scientific;
+    const char* expected;
+};
+
+static const FXtocstrTestCase fXtocstrShortestTestCases[] =
+{
+    { FT_D, 0x3ff0000000000000ULL, false, "1" },
+    { FT_D, 0x3fb999999999999aULL, false, "0.1" },
+    { FT_D, 0x3fd3333333333333ULL, false, "0.3" },
+    { FT_D, 0x3fd5555555555555ULL, false, "0.3333333333333333" },
+    { FT_D, 0x44b52d02c7e14af6ULL, false, "1e+23" },
+    { FT_D, 0x0000000000000001ULL, false, "5e-324" },
+    { FT_D, 0x000fffffffffffffULL, false, "2.225073858507201e-308" },
+    { FT_D, 0x7fefffffffffffffULL, false, "1.7976931348623157e+308" },
+    { FT_D, 0x4059000000000000ULL, false, "100" },
+    { FT_D, 0x4059000000000000ULL, true, "1e+2" },
+    { FT_D, 0xc004000000000000ULL, false, "-2.5" },
+    { FT_D, 0x3eb0c6f7a0b5ed8dULL, false, "1e-6" },
+    { FT_D, 0x8000000000000000ULL, false, "-0" },
+    { FT_D, 0x7ff0000000000000ULL, false, "inf" },
+    { FT_F, 0x3dcccccdU, false, "0.1" },
+    { FT_F, 0x3eaaaaabU, false, "0.33333334" },
+    { FT_F, 0x00000001U, false, "1e-45" },
+    { FT_F, 0x7f7fffffU, false, "3.4028235e+38" },
+    { FT_F, 0x4b800000U, false, "16777216" },
+    { FT_H, 0x3c00U, false, "1" },
+    { FT_H, 0x2e66U, false, "0.1" },
+    { FT_H, 0x0001U, false, "6e-8" },
+    { FT_H, 0x7bffU, false, "6.55e+4" },
+    { FT_H, 0x3555U, false, "0.3333" }
+};
+
+static void testFXtocstrShortest(cxuint testId, const FXtocstrTestCase& testCase)
+{
+    char buffer[64];
+    switch (testCase.type)
+    {
+        case FT_H:
+            htocstrShortestCStyle(testCase.value, buffer, 64, testCase.scientific);
+            break;
+        case FT_F:
+        {
+            FloatUnion v;
+            v.u = testCase.value;
+            ftocstrShortestCStyle(v.f, buffer, 64, testCase.scientific);
+            break;
+        }
+        case FT_D:
+        {
+            DoubleUnion v;
+            v.u = testCase.value;
+            dtocstrShortestCStyle(v.d, buffer, 64, testCase.scientific);
+            break;
+        }
+        default:
+            throw Exception("Unknown type");
+            break;
+    }
+    if (::strcmp(buffer, testCase.expected) != 0)
+    {
+        std::ostringstream oss;
+        oss << "Failed for shortest #" << testId << ". Result: " << buffer << "!=" <<
+                testCase.expected;
+        oss.flush();
+        throw Exception(oss.str());
+    }
+}
+
+struct FXtocstrFixedTestCase
+{
+    FloatType type;
+    uint64_t value;
+    cxuint precision;
+    bool scientific;
+    const char* expected;
+};
+
+static const FXtocstrFixedTestCase fXtocstrFixedTestCases[] =
+{
+    { FT_D, 0x3fc0000000000000ULL, 2, false, "0.12" },
+    { FT_D, 0x3fc0000000000000ULL, 1, true, "1.2e-01" },
+    { FT_D, 0x4004000000000000ULL, 0, false, "2" },
+    { FT_D, 0x3ff8000000000000ULL, 0, false, "2" },
+    { FT_D, 0x3fe0000000000000ULL, 0, false, "0" },
+    { FT_D, 0x3fb999999999999aULL, 20, false, "0.10000000000000000555" },
+    { FT_D, 0x3fb999999999999aULL, FXTOCSTR_EXACT_PRECISION, false,
+        "0.1000000000000000055511151231257827021181583404541015625" },
+    { FT_D, 0x3fb999999999999aULL, FXTOCSTR_EXACT_PRECISION, true,
+        "1.000000000000000055511151231257827021181583404541015625e-01" },
+    { FT_D, 0x4023ffae147ae148ULL, 2, false, "10.00" },
+    { FT_D, 0x4023ffae147ae148ULL, 2, true, "1.00e+01" },
+    { FT_D, 0x7e37e43c8800759cULL, 3, true, "1.000e+300" },
+    { FT_D, 0x0000000000000001ULL, 3, true, "4.941e-324" },
+    { FT_D, 0x0000000000000001ULL, 3, false, "0.000" },
+    { FT_D, 0x8000000000000000ULL, 2, false, "-0.00" },
+    { FT_D, 0x0000000000000000ULL, 3, true, "0.000e+00" },
+    { FT_D, 0xfff0000000000000ULL, 2, false, "-inf" },
+    { FT_D, 0x44b52d02c7e14af6ULL, 0, false, "99999999999999991611392" },
+    { FT_F, 0x3dcccccdU, 12, false, "0.100000001490" },
+    { FT_F, 0x3dcccccdU, FXTOCSTR_EXACT_PRECISION, false, "0.100000001490116119384765625" },
+    { FT_H, 0x3555U, FXTOCSTR_EXACT_PRECISION, false, "0.333251953125" },
+    { FT_H, 0x7bffU, 2, true, "6.55e+04" }
+};
+
+static void testFXtocstrFixed(cxuint testId, const FXtocstrFixedTestCase& testCase)
+{
+    char buffer[400];
+    switch (testCase.type)
+    {
+        case FT_H:
+            htocstrFixedCStyle(testCase.value, buffer, 400, testCase.precision,
+                    testCase.scientific);
+            break;
+        case FT_F:
+        {
+            FloatUnion v;
+            v.u = testCase.value;
+            ftocstrFixedCStyle(v.f, buffer, 400, testCase.precision, testCase.scientific);
+            break;
+        }
+        case FT_D:
+        {
+            DoubleUnion v;
+            v.u = testCase.value;
+            dtocstrFixedCStyle(v.d, buffer, 400, testCase.precision, testCase.scientific);
+            break;
+        }
+        default:
+            throw Exception("Unknown type");
+            break;
+    }
+    if (::strcmp(buffer, testCase.expected) != 0)
+    {
+        std::ostringstream oss;
+        oss << "Failed for fixed #" << testId << ". Result: " << buffer << "!=" <<
+                testCase.expected;
+        oss.flush();
+        throw Exception(oss.str());
+    }
+}
+
+static const FXtocstrTestCase fXtocstrHexTestCases[] =
+{
+    { FT_D, 0x3ff0000000000000ULL, false, "0x1p+0" },
+    { FT_D, 0x3fb999999999999aULL, false, "0x1.999999999999ap-4" },
+    { FT_D, 0xc008000000000000ULL, false, "-0x1.8p+1" },
+    { FT_D, 0x7fefffffffffffffULL, false, "0x1.fffffffffffffp+1023" },
+    { FT_D, 0x0000000000000001ULL, false, "0x0.0000000000001p-1022" },
+    { FT_D, 0x0008000000000000ULL, false, "0x0.8p-1022" },
+    { FT_D, 0x0000000000000000ULL, false, "0x0p+0" },
+    { FT_D, 0x8000000000000000ULL, false, "-0x0p+0" },
+    { FT_D, 0xfff0000000000000ULL, false, "-inf" },
+    { FT_F, 0x3dcccccdU, false, "0x1.99999ap-4" },
+    { FT_F, 0x7f7fffffU, false, "0x1.fffffep+127" },
+    { FT_F, 0x00000001U, false, "0x0.000002p-126" },
+    { FT_F, 0x4b800000U, false, "0x1p+24" },
+    { FT_H, 0x2e66U, false, "0x1.998p-4" },
+    { FT_H, 0x7bffU, false, "0x1.ffcp+15" },
+    { FT_H, 0x0001U, false, "0x0.004p-14" },
+    { FT_H, 0x7e00U, false, "nan" }
+};
+
+static void testFXtocstrHex(cxuint testId, const FXtocstrTestCase& testCase)
+{
+    char buffer[64];
+    switch (testCase.type)
+    {
+        case FT_H:
+            htocstrHexCStyle(testCase.value, buffer, 64);
+            break;
+        case FT_F:
+        {
+            FloatUnion v;
+            v.u = testCase.value;
+            ftocstrHexCStyle(v.f, buffer, 64);
+            break;
+        }
+        case FT_D:
+        {
+            DoubleUnion v;
+            v.u = testCase.value;
+            dtocstrHexCStyle(v.d, buffer, 64);
+            break;
+        }
+        default:
+            throw Exception("Unknown type");
+            break;
+    }
+    if (::strcmp(buffer, testCase.expected) != 0)
+    {
+        std::ostringstream oss;
+        oss << "Failed for hex #" << testId << ". Result: " << buffer << "!=" <<
+                testCase.expected;
+        oss.flush();
+        throw Exception(oss.str());
+    }
+}
+
+static_assert(DTOCSTR_SHORTEST_MAX_LENGTH == sizeof("-2.2250738585072014e-308")-1,
+              "wrong max length");
+static_assert(dtocstrFixedMaxLength(2) == 313, "wrong max length");
+static_assert(dtocstrFixedMaxLength(2, true) == 10, "wrong max length");
+
+/* precision bigger than INT_MAX must not be truncated to int (output does not fit) */
+static void testFXtocstrFixedHugePrecision()
+{
+    char buffer[64];
+    for (bool scientific: { false, true })
+    {
+        bool failed = false;
+        try
+        {
+            dtocstrFixedCStyle(1.0, buffer, 64, 0xfffffff0U, scientific);
+            failed = true;
+        }
+        catch(const Exception& ex)
+        { }
+        if (failed)
+            throw Exception("Failed for dtocstrFixed with huge precision");
+    }
+}
+
+/* non-throwing formatting must return length of full output */
+static void testFXtocstrNoThrow()
+{
+    char buffer[8];
+    char bigBuffer[DTOCSTR_MAX_LENGTH+1];
+    if (dtocstrNoThrowCStyle(0.1, buffer, 8) != 3 || ::strcmp(buffer, "0.1") != 0 ||
+        dtocstrNoThrowCStyle(1.0/3.0, buffer, 8, false, true) != 18 || buffer[0] != 0 ||
+        dtocstrNoThrowCStyle(1.0/3.0, nullptr, 0) != 19 ||
+        dtocstrNoThrowCStyle(-1.7976931348623157e+308, bigBuffer,
+                    DTOCSTR_MAX_LENGTH+1) != DTOCSTR_MAX_LENGTH ||
+        ftocstrHexNoThrowCStyle(0.1f, buffer, 8) != 13 || buffer[0] != 0 ||
+        htocstrNoThrowCStyle(0x3c00, buffer, 2) != 1 || ::strcmp(buffer, "1") != 0 ||
+        dtocstrFixedNoThrowCStyle(0.125, buffer, 8, 2) != 4 ||
+        ::strcmp(buffer, "0.12") != 0 ||
+        dtocstrFixedNoThrowCStyle(0.1, nullptr, 0, FXTOCSTR_EXACT_PRECISION) != 57 ||
+        dtocstrFixedNoThrowCStyle(2.0, buffer, 2, 0) != 1 || ::strcmp(buffer, "2") != 0)
+        throw Exception("Failed for fXtocstrNoThrow");
+    // measuring with huge precision must not format all digits
+    if (dtocstrFixedNoThrowCStyle(1.0, nullptr, 0, 0xfffffff0U) != 0xfffffff0ULL+2 ||
+        dtocstrFixedNoThrowCStyle(-1.0, nullptr, 0, 0xfffffff0U, true) !=
+                0xfffffff0ULL+7 ||
+        dtocstrFixedNoThrowCStyle(1.0, buffer, 8, 0xfffffff0U, true) !=
+                0xfffffff0ULL+6 || buffer[0] != 0)
+        throw Exception("Failed for dtocstrFixedNoThrow with huge precision");
+    // value just below power of 10 with precision above measured precision
+    const double below1e23 = 99999999999999991611392.0;
+    char fixedBuffer[200];
+    for (bool scientific: { false, true })
+        if (dtocstrFixedNoThrowCStyle(below1e23, nullptr, 0, 100, scientific) !=
+            dtocstrFixedCStyle(below1e23, fixedBuffer, 200, 100, scientific))
+            throw Exception("Failed for dtocstrFixedNoThrow measuring");
+}
+
+static void testFXtocstrArray()
+{
+    const double dvalues[4] = { 0.1, -2.5, 1e23, 0.0 };
+    const float fvalues[3] = { 0.1f, 16777216.0f, -1e-45f };
+    const cxushort hvalues[3] = { 0x3c00, 0x2e66, 0x7bff };
+    size_t offsets[4];
+    char buffer[64];
+    if (dtocstrArrayCStyle(4, dvalues, buffer, 64, ',', offsets, false, true) != 16 ||
+        ::strcmp(buffer, "0.1,-2.5,1e+23,0") != 0 || offsets[0] != 0 ||
+        offsets[1] != 4 || offsets[2] != 9 || offsets[3] != 15)
+        throw Exception("Failed for dtocstrArray");
+    if (ftocstrArrayCStyle(3, fvalues, buffer, 64, ' ', nullptr, true, true) != 24 ||
+        ::strcmp(buffer, "1e-1 1.6777216e+7 -1e-45") != 0)
+        throw Exception("Failed for ftocstrArray");
+    if (htocstrArrayCStyle(3, hvalues, buffer, 64, ';') != 13 ||
+        ::strcmp(buffer, "1;0.1;6.55e+4") != 0 ||
+        htocstrArrayCStyle(0, hvalues, buffer, 1) != 0 || buffer[0] != 0)
+        throw Exception("Failed for htocstrArray");
+    bool failed = false;
+    try
+    {   // output must not fit
+        dtocstrArrayCStyle(4, dvalues, buffer, 15);
+        failed = true;
+    }
+    catch(const Exception& ex)
+    { }
+    if (failed)
+        throw Exception("Failed for dtocstrArray with too small buffer");
+}
+
+/* compare parallel formatting of array with serial formatting */
+static void testFXtocstrArrayParallel()
+{
+    const size_t n = 50000;
+    std::vector<double> dvalues(n);
+    std::vector<cxushort> hvalues(n);
+    uint64_t seed = 88172645463325252ULL;
+    for (size_t i = 0; i < n; i++)
+    {
+        seed ^= seed<<13; seed ^= seed>>7; seed ^= seed<<17;
+        ::memcpy(&dvalues[i], &seed, 8);
+        hvalues[i] = seed & 0xffff;
+    }
+    const size_t maxSize = n*(DTOCSTR_MAX_LENGTH+1);
+    std::vector<char> expected(maxSize);
+    std::vector<char> result(maxSize);
+    std::vector<size_t> expectedOffsets(n);
+    std::vector<size_t> offsets(n);
+    for (bool shortest: { false, true })
+    {
+        size_t length = dtocstrArrayCStyle(n, dvalues.data(), expected.data(), maxSize,
+                    ' ', expectedOffsets.data(), false, shortest);
+        if (dtocstrArrayParallelCStyle(n, dvalues.data(), result.data(), maxSize,
+                    ' ', offsets.data(), false, shortest, 5) != length ||
+            ::strcmp(result.data(), expected.data()) != 0 || offsets != expectedOffsets)
+            throw Exception("Failed for dtocstrArrayParallel");
+        // output must not fit, string and offsets must not be changed
+        std::fill(result.begin(), result.end(), 'x');
+        std::fill(offsets.begin(), offsets.end(), size_t(7));
+        bool failed = false;
+        try
+        {
+            dtocstrArrayParallelCStyle(n, dvalues.data(), result.data(), length,
+                    ' ', offsets.data(), false, shortest, 5);
+            failed = true;
+        }
+        catch(const Exception& ex)
+        { }
+        if (failed || std::count(result.begin(), result.end(), 'x') != ptrdiff_t(maxSize) ||
+            std::count(offsets.begin(), offsets.end(), size_t(7)) != ptrdiff_t(n))
+            throw Exception("Failed for dtocstrArrayParallel with too small buffer");
+        length = htocstrArrayCStyle(n, hvalues.data(), expected.data(), maxSize,
+                    ';', expectedOffsets.data(), true, shortest);
+        if (htocstrArrayParallelCStyle(n, hvalues.data(), result.data(), maxSize,
+                    ';', offsets.data(), true, shortest, 3) != length ||
+            ::strcmp(result.data(), expected.data()) != 0 || offsets != expectedOffsets)
+            throw Exception("Failed for htocstrArrayParallel");
+    }
+}
+
+/* all half floats must be parsed back to this same value */
+static void testHalfShortestRoundTrip()
+{
+    char buffer[64];
+    for (cxuint value = 0; value < 0x10000; value++)
+    {
+        if ((value & 0x7c00) == 0x7c00)
+            continue; // skip infinities and nans
+        htocstrShortestCStyle(value, buffer, 64);
+        const char* end;
+        const cxushort result = cstrtohCStyle(buffer, buffer+::strlen(buffer), end);
+        if (result != value && (value & 0x7fff) != 0)
+        {
+            std::ostringstream oss;
+            oss << "Failed for half shortest round trip 0x" << std::hex << value <<
+                    ". Result: " << buffer;
+            oss.flush();
+            throw Exception(oss.str());
+        }
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    int retVal = 0;
+    for (cxuint i = 0; i < sizeof(fXtocstrShortestTestCases)/sizeof(FXtocstrTestCase); i++)
+        try
+        {
+            testFXtocstrShortest(i, fXtocstrShortestTestCases[i]);
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            retVal = 1;
+        }
+    for (cxuint i = 0; i < sizeof(fXtocstrFixedTestCases)/sizeof(FXtocstrFixedTestCase); i++)
+        try
+        {
+            testFXtocstrFixed(i, fXtocstrFixedTestCases[i]);
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            retVal = 1;
+        }
+    for (cxuint i = 0; i < sizeof(fXtocstrHexTestCases)/sizeof(FXtocstrTestCase); i++)
+        try
+        {
+            testFXtocstrHex(i, fXtocstrHexTestCases[i]);
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            retVal = 1;
+        }
+    try
+    {
+        testFXtocstrFixedHugePrecision();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    try
+    {
+        testFXtocstrNoThrow();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    try
+    {
+        testFXtocstrArray();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    try
+    {
+        testFXtocstrArrayParallel();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    try
+    {
+        testHalfShortestRoundTrip();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    return retVal;
+}
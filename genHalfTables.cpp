@@ -0,0 +1,73 @@
+/*
+ *  NumStringConv - number from/to string conversion utilities
+ *  Copyright (C) 2014 Mateusz Szpakowski
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/* generator of table of strings of all finite nonnegative half floats (used by
+ * htocstrCStyle). every row has human readable form and scientific form padded by
+ * null-characters to fixed size. must be linked with library built without tables
+ * of half floats */
+
+#include <cstdio>
+#include <cstring>
+#include <NumStringConv.h>
+
+using namespace CLRX;
+
+static const cxuint rowsNum = 0x7c00;
+static const cxuint hrSize = 10;
+static const cxuint scSize = 9;
+
+static void putField(const char* str, cxuint size)
+{
+    const size_t len = ::strlen(str);
+    for (cxuint i = 0; i < size; i++)
+        if (i < len)
+            putchar(str[i]);
+        else
+            fputs("\\000", stdout);
+}
+
+int main(int argc, const char** argv)
+{
+    printf("/* generated by genHalfTables - do not edit */\n\n"
+           "#define HALF_TABLE_HR_SIZE %u\n#define HALF_TABLE_SC_SIZE %u\n"
+           "#define HALF_TABLE_ROW_SIZE (HALF_TABLE_HR_SIZE+HALF_TABLE_SC_SIZE)\n\n"
+           "static const char halfStringsTable[%u*HALF_TABLE_ROW_SIZE+1] =\n",
+           hrSize, scSize, rowsNum);
+    char buffer[32];
+    try
+    {
+        for (cxuint value = 0; value < rowsNum; value++)
+        {
+            fputs("    \"", stdout);
+            if (htocstrCStyle(value, buffer, 32) > hrSize)
+                throw Exception("Too long human readable string");
+            putField(buffer, hrSize);
+            if (htocstrCStyle(value, buffer, 32, true) > scSize)
+                throw Exception("Too long scientific string");
+            putField(buffer, scSize);
+            puts((value+1 < rowsNum) ? "\"" : "\";");
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        fprintf(stderr, "Failed: %s\n", ex.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,219 @@
+/*
+ *  NumStringConv - number from/to string conversion utilities
+ *  Copyright (C) 2014 Mateusz Szpakowski
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/* generator of extended precision tables of powers of 5 (used by bigPow5).
+ * every entry is correctly rounded (to nearest even) and has format:
+ * (1 + value/2**(limbs*64)) * 2**exponent */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <cstdint>
+#include <vector>
+#define __STDC_FORMAT_MACROS
+#include <cinttypes>
+
+typedef std::vector<uint32_t> BigInt; // little endian
+
+/* default range of powers (covers full binary64 range for parsing and formatting) */
+static const int defaultMinPower = -1120;
+static const int defaultMaxPower = 352;
+
+static void bigMul5(BigInt& v)
+{
+    uint64_t carry = 0;
+    for (size_t i = 0; i < v.size(); i++)
+    {
+        carry += uint64_t(v[i])*5;
+        v[i] = carry;
+        carry >>= 32;
+    }
+    if (carry != 0)
+        v.push_back(carry);
+}
+
+static size_t bigBitLength(const BigInt& v)
+{
+    size_t bits = (v.size()-1)*32;
+    for (uint32_t t = v.back(); t != 0; t >>= 1)
+        bits++;
+    return bits;
+}
+
+static inline bool bigGetBit(const BigInt& v, size_t bit)
+{ return (bit>>5) < v.size() && ((v[bit>>5]>>(bit&31))&1) != 0; }
+
+static void bigShl1(BigInt& v)
+{
+    uint32_t carry = 0;
+    for (size_t i = 0; i < v.size(); i++)
+    {
+        const uint32_t next = v[i]>>31;
+        v[i] = (v[i]<<1) | carry;
+        carry = next;
+    }
+    if (carry != 0)
+        v.push_back(carry);
+}
+
+static bool bigGreaterEqual(const BigInt& a, const BigInt& b)
+{
+    size_t asize = a.size();
+    while (asize > 1 && a[asize-1] == 0) asize--;
+    size_t bsize = b.size();
+    while (bsize > 1 && b[bsize-1] == 0) bsize--;
+    if (asize != bsize)
+        return asize > bsize;
+    for (size_t i = asize; i > 0; i--)
+        if (a[i-1] != b[i-1])
+            return a[i-1] > b[i-1];
+    return true;
+}
+
+static void bigSubInPlace(BigInt& a, const BigInt& b)
+{
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        int64_t t = int64_t(a[i]) - (i < b.size() ? b[i] : 0) - borrow;
+        borrow = (t < 0);
+        a[i] = t + (borrow<<32);
+    }
+}
+
+/* generate fraction bits (without integer one) and exponent of 5**power */
+static void genPow5(int power, size_t limbs, std::vector<uint64_t>& value, int& exponent)
+{
+    BigInt pow5(1, 1);
+    for (int i = 0; i < std::abs(power); i++)
+        bigMul5(pow5);
+
+    const size_t fracBits = limbs*64;
+    std::vector<bool> bits; // fraction bits from most significant and guard bit
+    bool sticky = false;
+    if (power >= 0)
+    {
+        const size_t nbits = bigBitLength(pow5);
+        exponent = nbits-1;
+        for (size_t i = 0; i <= fracBits; i++)
+            bits.push_back(nbits >= i+2 && bigGetBit(pow5, nbits-2-i));
+        for (size_t i = 0; !sticky && nbits >= fracBits+3 && i < nbits-fracBits-2; i++)
+            sticky = bigGetBit(pow5, i);
+    }
+    else
+    {   // long division 1/5**power
+        BigInt rem(1, 1);
+        exponent = 0;
+        bool first = true;
+        while (bits.size() <= fracBits)
+        {
+            bigShl1(rem);
+            const bool bit = bigGreaterEqual(rem, pow5);
+            if (bit)
+                bigSubInPlace(rem, pow5);
+            if (first)
+            {
+                exponent--;
+                if (bit) // found integer one
+                    first = false;
+            }
+            else
+                bits.push_back(bit);
+        }
+        for (size_t i = 0; i < rem.size(); i++)
+            sticky |= (rem[i] != 0);
+    }
+
+    value.assign(limbs, 0);
+    for (size_t i = 0; i < fracBits; i++)
+        if (bits[i])
+            value[(fracBits-1-i)>>6] |= 1ULL<<((fracBits-1-i)&63);
+    // round to nearest even
+    if (bits[fracBits] && (sticky || (value[0]&1) != 0))
+    {
+        bool carry = true;
+        for (size_t i = 0; i < limbs && carry; i++)
+        {
+            value[i]++;
+            carry = (value[i] == 0);
+        }
+        if (carry) // all fraction is zeroed, increment exponent
+            exponent++;
+    }
+}
+
+static bool parseArg(const char* arg, long& out)
+{
+    char* endptr;
+    errno = 0;
+    out = strtol(arg, &endptr, 10);
+    return errno == 0 && *endptr == 0 && endptr != arg;
+}
+
+int main(int argc, const char** argv)
+{
+    if (argc < 3)
+    {
+        puts("Usage: genPow5Tables stride limbs [minPower maxPower]");
+        return 0;
+    }
+    long stride, limbs;
+    long minPower = defaultMinPower, maxPower = defaultMaxPower;
+    if (!parseArg(argv[1], stride) || !parseArg(argv[2], limbs) ||
+        (argc >= 5 && (!parseArg(argv[3], minPower) || !parseArg(argv[4], maxPower))))
+    {
+        fputs("Cant parse arguments\n", stderr);
+        return 1;
+    }
+    // rest of power must be exact in single 64-bit value (5**27 < 2**64)
+    if (stride < 1 || stride > 16 || (stride & (stride-1)) != 0)
+    {
+        fputs("Stride must be power of two not greater than 16\n", stderr);
+        return 1;
+    }
+    if (limbs < 3 || limbs > 64)
+    {
+        fputs("Limbs must be in range 3-64\n", stderr);
+        return 1;
+    }
+    // align range to stride
+    minPower = -((-minPower + stride-1)/stride)*stride;
+    maxPower = ((maxPower + stride-1)/stride)*stride;
+
+    printf("/* generated by genPow5Tables - do not edit */\n\n"
+           "#define POW5_TABLE_STRIDE %ld\n#define POW5_TABLE_LIMBS %ld\n"
+           "#define POW5_TABLE_MIN_POWER (%ld)\n#define POW5_TABLE_MAX_POWER (%ld)\n\n"
+           "struct Pow5BigTableEntry\n{\n    uint64_t value[POW5_TABLE_LIMBS];\n"
+           "    int exponent;\n};\n\n"
+           "static const Pow5BigTableEntry pow5BigTable[%ld] =\n{\n",
+           stride, limbs, minPower, maxPower, (maxPower-minPower)/stride + 1);
+    std::vector<uint64_t> value;
+    for (long power = minPower; power <= maxPower; power += stride)
+    {
+        int exponent;
+        genPow5(power, limbs, value, exponent);
+        printf("    { {");
+        for (long i = 0; i < limbs; i++)
+            printf("%s0x%016" PRIx64 "ULL%s", (i%3 == 0) ? "\n        " : " ",
+                    value[i], (i+1 < limbs) ? "," : "");
+        printf(" },\n      %d }%s\n", exponent, (power+stride <= maxPower) ? "," : "");
+    }
+    puts("};");
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ *  NumStringConv - number from/to string conversion utilities
+ *  Copyright (C) 2014 Mateusz Szpakowski
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/* benchmark of decimal formatting of 64-bit integers: u64tocstrCStyle versus
+ * simple division loop (one digit per division) and snprintf */
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+#define __STDC_FORMAT_MACROS
+#include <cinttypes>
+#include <NumStringConv.h>
+
+using namespace CLRX;
+
+/* reference: one digit per division, reversed temporary buffer */
+static size_t u64tocstrDivLoop(uint64_t value, char* str)
+{
+    char buffer[20];
+    cxuint digitsNum = 0;
+    do {
+        const uint64_t tmp = value/10U;
+        buffer[digitsNum++] = '0' + cxuint(value - tmp*10U);
+        value = tmp;
+    } while (value != 0);
+    for (cxuint i = 0; i < digitsNum; i++)
+        str[i] = buffer[digitsNum-1-i];
+    str[digitsNum] = 0;
+    return digitsNum;
+}
+
+enum BenchFunc
+{
+    BENCH_U64TOCSTR = 0,
+    BENCH_DIVLOOP,
+    BENCH_SNPRINTF
+};
+
+static const char* benchFuncNames[3] = { "u64tocstrCStyle", "division loop", "snprintf" };
+
+static double runBench(BenchFunc func, const std::vector<uint64_t>& values,
+            cxuint repeats, size_t& totalLength)
+{
+    char buffer[32];
+    totalLength = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (cxuint r = 0; r < repeats; r++)
+        for (uint64_t value: values)
+            switch(func)
+            {
+                case BENCH_U64TOCSTR:
+                    totalLength += u64tocstrCStyle(value, buffer, 32);
+                    break;
+                case BENCH_DIVLOOP:
+                    totalLength += u64tocstrDivLoop(value, buffer);
+                    break;
+                default:
+                    totalLength += snprintf(buffer, 32, "%" PRIu64, value);
+                    break;
+            }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end-start).count() /
+            (double(values.size())*repeats);
+}
+
+int main(int argc, const char** argv)
+{
+    size_t valuesNum = 1000000;
+    if (argc >= 2)
+    {
+        char* endptr;
+        errno = 0;
+        valuesNum = strtoul(argv[1], &endptr, 10);
+        if (errno != 0 || *endptr != 0 || endptr == argv[1] || valuesNum == 0)
+        {
+            fputs("Cant parse number of values\n", stderr);
+            return 1;
+        }
+    }
+    // xorshift random generator (reproducible results)
+    uint64_t seed = 88172645463325252ULL;
+    std::vector<uint64_t> fullValues(valuesNum);
+    std::vector<uint64_t> mixedValues(valuesNum);
+    for (size_t i = 0; i < valuesNum; i++)
+    {
+        seed ^= seed<<13; seed ^= seed>>7; seed ^= seed<<17;
+        fullValues[i] = seed;
+        mixedValues[i] = seed >> (seed%64); // uniform bit lengths
+    }
+
+    const std::vector<uint64_t>* valueSets[2] = { &fullValues, &mixedValues };
+    const char* valueSetNames[2] = { "full 64-bit", "mixed length" };
+    for (cxuint set = 0; set < 2; set++)
+    {
+        printf("%s values:\n", valueSetNames[set]);
+        size_t expectedLength = 0;
+        for (cxuint func = BENCH_U64TOCSTR; func <= BENCH_SNPRINTF; func++)
+        {
+            size_t totalLength;
+            const double nsPerValue = runBench(BenchFunc(func), *valueSets[set],
+                        5, totalLength);
+            if (func == BENCH_U64TOCSTR)
+                expectedLength = totalLength;
+            else if (totalLength != expectedLength)
+            {
+                fprintf(stderr, "Length mismatch for %s\n", benchFuncNames[func]);
+                return 1;
+            }
+            printf("  %-16s %8.2f ns/value\n", benchFuncNames[func], nsPerValue);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,330 @@
+/*
+ *  NumStringConv - number from/to string conversion utilities
+ *  Copyright (C) 2014 Mateusz Szpakowski
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <iostream>
+#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <NumStringConv.h>
+
+using namespace CLRX;
+
+/* simple xorshift generator (reproducible test data) */
+static uint64_t randomState = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t randomValue()
+{
+    randomState ^= randomState<<13;
+    randomState ^= randomState>>7;
+    randomState ^= randomState<<17;
+    return randomState;
+}
+
+struct CStrto128TestCase
+{
+    const char* string;
+    bool isSigned;
+    uint64_t expected[2];
+    bool outOfRange;
+};
+
+static const CStrto128TestCase cstrto128TestCases[] =
+{
+    { "0", false, { 0, 0 }, false },
+    { "12345678901234567890123", false, { 0x42b64e76714244cbULL, 0x29d }, false },
+    { "340282366920938463463374607431768211455", false, { UINT64_MAX, UINT64_MAX }, false },
+    { "340282366920938463463374607431768211456", false, { }, true },
+    { "999999999999999999999999999999999999999", false, { }, true },
+    { "0xffeeddccbbaa99887766554433221100", false,
+        { 0x7766554433221100ULL, 0xffeeddccbbaa9988ULL }, false },
+    { "0x1ffeeddccbbaa99887766554433221100", false, { }, true },
+    { "0b11", false, { 3, 0 }, false },
+    { "03777777777777777777777777777777777777777777", false,
+        { UINT64_MAX, UINT64_MAX }, false },
+    { "-1", true, { UINT64_MAX, UINT64_MAX }, false },
+    { "-170141183460469231731687303715884105728", true, { 0, 1ULL<<63 }, false },
+    { "-170141183460469231731687303715884105729", true, { }, true },
+    { "170141183460469231731687303715884105727", true, { UINT64_MAX, INT64_MAX }, false },
+    { "170141183460469231731687303715884105728", true, { }, true },
+    { "-0x10", true, { UINT64_MAX-15, UINT64_MAX }, false }
+};
+
+static void testCStrto128(cxuint testId, const CStrto128TestCase& testCase)
+{
+    uint64_t result[2];
+    const char* end;
+    bool outOfRange = false;
+    const char* strend = testCase.string+::strlen(testCase.string);
+    try
+    {
+        if (testCase.isSigned)
+            cstrtoi128CStyle(testCase.string, strend, end, result);
+        else
+            cstrtou128CStyle(testCase.string, strend, end, result);
+    }
+    catch(const ParseException& ex)
+    { outOfRange = true; }
+    bool good = (outOfRange == testCase.outOfRange) && (outOfRange ||
+            (::memcmp(result, testCase.expected, 16) == 0 && end == strend));
+    if (good && !outOfRange && !testCase.isSigned)
+    {   // format in this same radix
+        const char* str = testCase.string;
+        const cxuint radix = (str[0] != '0' || str[1] == 0) ? 10 :
+                (str[1] == 'x') ? 16 : (str[1] == 'b') ? 2 : 8;
+        char buf[140];
+        u128tocstrCStyle(result, buf, 140, radix);
+        good = ::strcmp(buf, str) == 0;
+    }
+    if (!good)
+    {
+        std::ostringstream oss;
+        oss << "Failed for cstrto128 #" << testId << " with string='" <<
+                testCase.string << "'";
+        oss.flush();
+        throw Exception(oss.str());
+    }
+}
+
+/* decimal formatting of 128-bit values at borders of 19-digit chunks */
+static void testU128toCStrDecimal()
+{
+    const uint64_t values[6][2] = {
+        { 0, 1 }, // 2**64
+        { 0x098a223fffffffffULL, 0x4b3b4ca85a86c47aULL }, // 10**38-1
+        { 0x098a224000000000ULL, 0x4b3b4ca85a86c47aULL }, // 10**38
+        { 0x6bc75e2d63100000ULL, 0x5ULL }, // 10**20
+        { 0xffffffffffffffffULL, 0x7fffffffffffffffULL },
+        { 0xffffffffffffffffULL, 0xffffffffffffffffULL }
+    };
+    const char* expected[6] = {
+        "18446744073709551616", "99999999999999999999999999999999999999",
+        "100000000000000000000000000000000000000", "100000000000000000000",
+        "170141183460469231731687303715884105727",
+        "340282366920938463463374607431768211455"
+    };
+    for (cxuint i = 0; i < 6; i++)
+    {
+        char buf[48];
+        if (u128tocstrCStyle(values[i], buf, 48) != ::strlen(expected[i]) ||
+            ::strcmp(buf, expected[i]) != 0)
+        {
+            std::ostringstream oss;
+            oss << "Failed for u128tocstr #" << i << ". Result: " << buf << "!=" <<
+                    expected[i];
+            oss.flush();
+            throw Exception(oss.str());
+        }
+    }
+    char buf[48];
+    if (u128tocstrCStyle(values[0], buf, 48, 10, 24) != 24 ||
+        ::strcmp(buf, "    18446744073709551616") != 0)
+        throw Exception("Failed for u128tocstr with width");
+}
+
+struct U64toCStrTestCase
+{
+    uint64_t value;
+    cxuint radix;
+    cxuint width;
+    bool prefix;
+    cxuint flags;
+    const char* expected;
+};
+
+static const U64toCStrTestCase u64toCStrTestCases[] =
+{
+    { 0xdeadbeefULL, 16, 0, true, 0, "0xdeadbeef" },
+    { 0xdeadbeefULL, 16, 0, true, UXTOCSTR_UPPERCASE, "0XDEADBEEF" },
+    { 0xdeadbeefULL, 16, 0, false, UXTOCSTR_GROUP_DIGITS, "dead_beef" },
+    { 0xbeefULL, 16, 12, true, UXTOCSTR_UPPERCASE|UXTOCSTR_GROUP_DIGITS,
+        "0X0000_0000_BEEF" },
+    { UINT64_MAX, 16, 0, false, 0, "ffffffffffffffff" },
+    { 0x0123456789abcdefULL, 16, 0, false, 0, "123456789abcdef" },
+    { 0x2dULL, 2, 0, true, UXTOCSTR_GROUP_DIGITS|UXTOCSTR_UPPERCASE, "0B10_1101" },
+    { 0x8000000000000001ULL, 2, 0, false, 0,
+        "1000000000000000000000000000000000000000000000000000000000000001" },
+    { 01234567ULL, 8, 0, true, UXTOCSTR_GROUP_DIGITS, "01_234_567" },
+    { UINT64_MAX, 8, 0, true, 0, "01777777777777777777777" },
+    { 1234567ULL, 10, 0, true, UXTOCSTR_GROUP_DIGITS, "1_234_567" },
+    { 1234567ULL, 10, 12, true, UXTOCSTR_GROUP_DIGITS, "   1_234_567" },
+    { 123ULL, 10, 0, true, UXTOCSTR_GROUP_DIGITS, "123" },
+    { 0ULL, 16, 0, true, UXTOCSTR_GROUP_DIGITS, "0x0" }
+};
+
+static void testU64toCStr(cxuint testId, const U64toCStrTestCase& testCase)
+{
+    char buf[100];
+    u64tocstrCStyle(testCase.value, buf, 100, testCase.radix, testCase.width,
+                testCase.prefix, testCase.flags);
+    if (::strcmp(buf, testCase.expected) != 0)
+    {
+        std::ostringstream oss;
+        oss << "Failed for u64tocstr #" << testId << ". Result: " << buf << "!=" <<
+                testCase.expected;
+        oss.flush();
+        throw Exception(oss.str());
+    }
+}
+
+static_assert(u64tocstrMaxLength(2) == 66, "wrong max length");
+static_assert(u64tocstrMaxLength(10) == 20, "wrong max length");
+static_assert(u64tocstrMaxLength(16, 0, true, UXTOCSTR_GROUP_DIGITS) == 21,
+              "wrong max length");
+static_assert(u32tocstrMaxLength(8) == 12, "wrong max length");
+static_assert(u128tocstrMaxLength(10, 50) == 50, "wrong max length");
+
+/* non-throwing formatting must return length of full output */
+static void testU64toCStrNoThrow()
+{
+    char buf[32];
+    const uint64_t value128[2] = { UINT64_MAX, UINT64_MAX };
+    const char* expected128 = "340282366920938463463374607431768211455";
+    if (u64tocstrNoThrowCStyle(UINT64_MAX, nullptr, 0) != 20 ||
+        u64tocstrNoThrowCStyle(0xabcdULL, buf, 3, 16, 8) != 10 || buf[0] != 0 ||
+        u64tocstrNoThrowCStyle(12345ULL, buf, 6) != 5 || ::strcmp(buf, "12345") != 0 ||
+        u64tocstrNoThrowCStyle(12345ULL, buf, 32, 7) != 0 ||
+        u128tocstrNoThrowCStyle(value128, buf, 32) != 39 || buf[0] != 0 ||
+        u128tocstrNoThrowCStyle(value128, nullptr, 0, 10, 45) != 45)
+        throw Exception("Failed for u64tocstrNoThrow");
+    char buf128[40];
+    if (u128tocstrNoThrowCStyle(value128, buf128, 40) != 39 ||
+        ::strcmp(buf128, expected128) != 0)
+        throw Exception("Failed for u128tocstrNoThrow");
+}
+
+static void testU64toCStrArray()
+{
+    const uint64_t values[4] = { 0, 12345678901234567890ULL, 7, 0xffULL };
+    const uint32_t values32[3] = { 1, UINT32_MAX, 100 };
+    size_t offsets[4];
+    char buf[80];
+    if (u64tocstrArrayCStyle(4, values, buf, 80, ',', offsets) != 28 ||
+        ::strcmp(buf, "0,12345678901234567890,7,255") != 0 ||
+        offsets[0] != 0 || offsets[1] != 2 || offsets[2] != 23 || offsets[3] != 25)
+        throw Exception("Failed for u64tocstrArray");
+    if (u64tocstrArrayCStyle(4, values, buf, 80, ' ', nullptr, 16, 4) != 39 ||
+        ::strcmp(buf, "0x0000 0xab54a98ceb1f0ad2 0x0007 0x00ff") != 0)
+        throw Exception("Failed for u64tocstrArray with radix 16");
+    if (u32tocstrArrayCStyle(3, values32, buf, 80, '\n') != 16 ||
+        ::strcmp(buf, "1\n4294967295\n100") != 0)
+        throw Exception("Failed for u32tocstrArray");
+}
+
+/* compare parallel formatting of array with serial formatting */
+static void testU64toCStrArrayParallel()
+{
+    const size_t n = 100000;
+    std::vector<uint64_t> values(n);
+    for (uint64_t& value: values)
+        value = randomValue() >> (randomValue()%64);
+    const size_t maxSize = n*24;
+    std::vector<char> expected(maxSize);
+    std::vector<char> result(maxSize);
+    std::vector<size_t> expectedOffsets(n);
+    std::vector<size_t> offsets(n);
+    for (cxuint radix: { 10, 16 })
+    {
+        const size_t length = u64tocstrArrayCStyle(n, values.data(), expected.data(),
+                    maxSize, ',', expectedOffsets.data(), radix);
+        for (cxuint threadsNum: { 1, 3, 8 })
+            if (u64tocstrArrayParallelCStyle(n, values.data(), result.data(), maxSize,
+                    ',', offsets.data(), radix, 0, true, 0, threadsNum) != length ||
+                ::strcmp(result.data(), expected.data()) != 0 || offsets != expectedOffsets)
+                throw Exception("Failed for u64tocstrArrayParallel");
+        // output must not fit, string and offsets must not be changed
+        std::fill(result.begin(), result.end(), 'x');
+        std::fill(offsets.begin(), offsets.end(), size_t(7));
+        bool failed = false;
+        try
+        {
+            u64tocstrArrayParallelCStyle(n, values.data(), result.data(), length, ',',
+                    offsets.data(), radix, 0, true, 0, 4);
+            failed = true;
+        }
+        catch(const Exception& ex)
+        { }
+        if (failed || std::count(result.begin(), result.end(), 'x') != ptrdiff_t(maxSize) ||
+            std::count(offsets.begin(), offsets.end(), size_t(7)) != ptrdiff_t(n))
+            throw Exception("Failed for u64tocstrArrayParallel with too small buffer");
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    int retVal = 0;
+    for (cxuint i = 0; i < sizeof(cstrto128TestCases)/sizeof(CStrto128TestCase); i++)
+        try
+        {
+            testCStrto128(i, cstrto128TestCases[i]);
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            retVal = 1;
+        }
+    for (cxuint i = 0; i < sizeof(u64toCStrTestCases)/sizeof(U64toCStrTestCase); i++)
+        try
+        {
+            testU64toCStr(i, u64toCStrTestCases[i]);
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            retVal = 1;
+        }
+    try
+    {
+        testU128toCStrDecimal();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    try
+    {
+        testU64toCStrNoThrow();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    try
+    {
+        testU64toCStrArray();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    try
+    {
+        testU64toCStrArrayParallel();
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        retVal = 1;
+    }
+    return retVal;
+}